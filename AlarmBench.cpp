@@ -0,0 +1,89 @@
+// Alarm display along the GUI path: AlarmEngine transitions applied through
+// GridSystem::applyAlarms() must give warning and critical cells their own
+// strategies, distinct from the default, and a return to nominal must bring
+// back the strategy the cell had before, or the one set while it was alarmed.
+// When several batches arrive between two applyAlarms() calls, as they do
+// within one drain, the transitions of every batch must reach the grid.
+#include "Bench.h"
+#include "AlarmEngine.h"
+#include "CellStrategy.h"
+#include "GridSystem.h"
+#include "Renderer.h"
+#include <cstdio>
+
+namespace SkyLink {
+
+    namespace {
+
+        void post(AlarmEngine& alarms, GridSystem& grid, double first, double second, double third) {
+            const Sample samples[] = {
+                Sample::fromDouble(0, 0, first),
+                Sample::fromDouble(1, 0, second),
+                Sample::fromDouble(2, 0, third),
+            };
+            alarms.onSamples(SampleSpan(samples, 3));
+            grid.applyAlarms(alarms);
+            alarms.clearTransitions();
+        }
+
+        template <typename Strategy>
+        bool uses(const GridCell& cell) {
+            return dynamic_cast<const Strategy*>(cell.strategy.get()) != nullptr;
+        }
+
+    } // namespace
+
+    bool benchAlarmDisplay() {
+        GridSystem grid(1, 3);
+        for (ChannelId channel = 0; channel < 3; ++channel) {
+            grid.cells[channel]->channel = channel;
+        }
+        grid.reindexChannels();
+        grid.cells[2]->setStrategy(new TriangleBlueCellStrategy());
+        const CellStrategy* defaultStrategy = grid.cells[0]->strategy.get();
+        const CellStrategy* blueStrategy = grid.cells[2]->strategy.get();
+
+        AlarmEngine alarms(3);
+        for (ChannelId channel = 0; channel < 3; ++channel) {
+            alarms.setLimits(channel, AlarmLimits{ -100.0, -50.0, 50.0, 100.0 });
+        }
+
+        post(alarms, grid, 75.0, 150.0, -150.0);
+        const bool alarmed = uses<TriangleYellowCellStrategy>(*grid.cells[0]) &&
+            uses<CriticalCellStrategy>(*grid.cells[1]) && uses<CriticalCellStrategy>(*grid.cells[2]) &&
+            !uses<TriangleCellStrategy>(*grid.cells[1]);
+
+        Renderer renderer;
+        for (auto& cell : grid.cells) {
+            cell->draw(renderer);
+        }
+
+        // A strategy chosen during the alarm waits for nominal
+        grid.cells[1]->setStrategy(new TriangleYellowCellStrategy());
+        const CellStrategy* chosenStrategy = grid.cells[1]->nominalStrategy.get();
+        const bool stillCritical = uses<CriticalCellStrategy>(*grid.cells[1]);
+
+        post(alarms, grid, 75.0, 75.0, 0.0);
+        const bool downgraded = uses<TriangleYellowCellStrategy>(*grid.cells[1]) && grid.cells[2]->strategy.get() == blueStrategy;
+        post(alarms, grid, 0.0, 0.0, 0.0);
+        const bool restored = grid.cells[0]->strategy.get() == defaultStrategy &&
+            grid.cells[1]->strategy.get() == chosenStrategy && grid.cells[2]->strategy.get() == blueStrategy;
+
+        // Two batches in one drain: channel 0 goes critical in the first, channel 1 warns in the second
+        const Sample first = Sample::fromDouble(0, 1, 150.0);
+        const Sample second = Sample::fromDouble(1, 1, 75.0);
+        alarms.onSamples(SampleSpan(&first, 1));
+        alarms.onSamples(SampleSpan(&second, 1));
+        const std::size_t pending = alarms.transitions().size();
+        grid.applyAlarms(alarms);
+        alarms.clearTransitions();
+        const bool bothBatches = pending == 2 && uses<CriticalCellStrategy>(*grid.cells[0]) &&
+            uses<TriangleYellowCellStrategy>(*grid.cells[1]) && alarms.transitions().empty();
+
+        std::printf("alarm strategies distinct: %s, set during alarm deferred: %s, critical to warning: %s, nominal restores: %s, "
+            "%zu transitions from two batches applied: %s\n", alarmed ? "yes" : "no", stillCritical ? "yes" : "no",
+            downgraded ? "yes" : "no", restored ? "yes" : "no", pending, bothBatches ? "yes" : "no");
+        return alarmed && stillCritical && downgraded && restored && bothBatches;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,162 @@
+#include "AlarmEngine.h"
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKYLINK_ALARM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace SkyLink {
+
+    namespace {
+
+        inline unsigned lowestBit(std::uint64_t word) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+        }
+
+        inline unsigned bitCount(std::uint64_t word) {
+            unsigned count = 0;
+            for (; word != 0; word &= word - 1) {
+                ++count;
+            }
+            return count;
+        }
+
+        inline AlarmLevel levelOf(std::uint64_t warning, std::uint64_t critical, unsigned bit) {
+            if ((critical >> bit) & 1) {
+                return AlarmLevel::Critical;
+            }
+            return ((warning >> bit) & 1) ? AlarmLevel::Warning : AlarmLevel::Nominal;
+        }
+
+    } // namespace
+
+    AlarmEngine::AlarmEngine(std::size_t channelCount) {
+        reserveChannels(channelCount);
+    }
+
+    void AlarmEngine::reserveChannels(std::size_t channelCount) {
+        const std::size_t words = (channelCount + 63) / 64;
+        if (words <= warningBits.size()) {
+            return;
+        }
+        // Unused slots get infinite limits and a zero value, so they never alarm
+        const std::size_t padded = words * 64;
+        const double infinity = std::numeric_limits<double>::infinity();
+        values.resize(padded, 0.0);
+        redLow.resize(padded, -infinity);
+        yellowLow.resize(padded, -infinity);
+        yellowHigh.resize(padded, infinity);
+        redHigh.resize(padded, infinity);
+        warningBits.resize(words, 0);
+        criticalBits.resize(words, 0);
+    }
+
+    void AlarmEngine::setLimits(ChannelId channel, const AlarmLimits& limits) {
+        reserveChannels(static_cast<std::size_t>(channel) + 1);
+        redLow[channel] = limits.redLow;
+        yellowLow[channel] = limits.yellowLow;
+        yellowHigh[channel] = limits.yellowHigh;
+        redHigh[channel] = limits.redHigh;
+    }
+
+    void AlarmEngine::clearLimits(ChannelId channel) {
+        if (channel >= values.size()) {
+            return;
+        }
+        const double infinity = std::numeric_limits<double>::infinity();
+        redLow[channel] = -infinity;
+        yellowLow[channel] = -infinity;
+        yellowHigh[channel] = infinity;
+        redHigh[channel] = infinity;
+    }
+
+    void AlarmEngine::onSamples(SampleSpan samples) {
+        const std::size_t channelCount = values.size();
+        for (const Sample& sample : samples) {
+            if (sample.channel < channelCount) {
+                values[sample.channel] = sample.asDouble();
+            }
+        }
+        evaluate();
+    }
+
+    void AlarmEngine::evaluate() {
+        for (std::size_t word = 0; word < warningBits.size(); ++word) {
+            const std::size_t base = word * 64;
+            const double* v = values.data() + base;
+            const double* rl = redLow.data() + base;
+            const double* yl = yellowLow.data() + base;
+            const double* yh = yellowHigh.data() + base;
+            const double* rh = redHigh.data() + base;
+            std::uint64_t outsideYellow = 0;
+            std::uint64_t outsideRed = 0;
+
+#ifdef SKYLINK_ALARM_SSE2
+            for (unsigned i = 0; i < 64; i += 2) {
+                const __m128d x = _mm_loadu_pd(v + i);
+                const __m128d red = _mm_or_pd(_mm_cmplt_pd(x, _mm_loadu_pd(rl + i)), _mm_cmpgt_pd(x, _mm_loadu_pd(rh + i)));
+                const __m128d yellow = _mm_or_pd(_mm_cmplt_pd(x, _mm_loadu_pd(yl + i)), _mm_cmpgt_pd(x, _mm_loadu_pd(yh + i)));
+                outsideRed |= static_cast<std::uint64_t>(_mm_movemask_pd(red)) << i;
+                outsideYellow |= static_cast<std::uint64_t>(_mm_movemask_pd(yellow)) << i;
+            }
+#else
+            for (unsigned i = 0; i < 64; ++i) {
+                outsideRed |= static_cast<std::uint64_t>((v[i] < rl[i]) | (v[i] > rh[i])) << i;
+                outsideYellow |= static_cast<std::uint64_t>((v[i] < yl[i]) | (v[i] > yh[i])) << i;
+            }
+#endif
+
+            const std::uint64_t critical = outsideRed;
+            const std::uint64_t warning = outsideYellow & ~outsideRed;
+            const std::uint64_t oldCritical = criticalBits[word];
+            const std::uint64_t oldWarning = warningBits[word];
+            std::uint64_t changed = (critical ^ oldCritical) | (warning ^ oldWarning);
+            if (changed == 0) {
+                continue;
+            }
+
+            criticalBits[word] = critical;
+            warningBits[word] = warning;
+            for (; changed != 0; changed &= changed - 1) {
+                const unsigned bit = lowestBit(changed);
+                changes.push_back(Transition{ static_cast<ChannelId>(base + bit),
+                    levelOf(oldWarning, oldCritical, bit), levelOf(warning, critical, bit) });
+            }
+        }
+    }
+
+    AlarmLevel AlarmEngine::level(ChannelId channel) const {
+        if (channel >= values.size()) {
+            return AlarmLevel::Nominal;
+        }
+        return levelOf(warningBits[channel / 64], criticalBits[channel / 64], channel % 64);
+    }
+
+    std::size_t AlarmEngine::warningCount() const {
+        std::size_t count = 0;
+        for (std::uint64_t word : warningBits) {
+            count += bitCount(word);
+        }
+        return count;
+    }
+
+    std::size_t AlarmEngine::criticalCount() const {
+        std::size_t count = 0;
+        for (std::uint64_t word : criticalBits) {
+            count += bitCount(word);
+        }
+        return count;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,66 @@
+#ifndef SKYLINE_ALARMENGINE_H
+#define SKYLINE_ALARMENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Observer.h"
+
+namespace SkyLink {
+
+    enum class AlarmLevel : std::uint8_t { Nominal, Warning, Critical };
+
+    struct AlarmLimits {
+        double redLow;
+        double yellowLow;
+        double yellowHigh;
+        double redHigh;
+    };
+
+    // Red/yellow limit checking for every channel at once. Latest values and
+    // limits are kept as parallel arrays; each delivered batch is followed by
+    // one pass over all channels that builds warning/critical bitmasks and
+    // records only the channels whose level changed. Those transitions pile up
+    // across batches until the consumer takes them with clearTransitions(), so
+    // a drain that delivers several batches loses none.
+    class AlarmEngine : public Observer {
+    public:
+        struct Transition {
+            ChannelId channel;
+            AlarmLevel from;
+            AlarmLevel to;
+        };
+
+        explicit AlarmEngine(std::size_t channelCount = 0);
+
+        void setLimits(ChannelId channel, const AlarmLimits& limits);
+        void clearLimits(ChannelId channel);
+
+        void onSamples(SampleSpan samples) override; // stores values, then evaluate()
+        void evaluate();
+
+        AlarmLevel level(ChannelId channel) const;
+        // Level changes found since the last clearTransitions(), oldest first
+        const std::vector<Transition>& transitions() const { return changes; }
+        void clearTransitions() { changes.clear(); }
+        std::size_t warningCount() const;
+        std::size_t criticalCount() const;
+
+    private:
+        void reserveChannels(std::size_t channelCount);
+
+        std::vector<double> values;
+        std::vector<double> redLow;
+        std::vector<double> yellowLow;
+        std::vector<double> yellowHigh;
+        std::vector<double> redHigh;
+
+        // One bit per channel, 64 channels per word
+        std::vector<std::uint64_t> warningBits;
+        std::vector<std::uint64_t> criticalBits;
+        std::vector<Transition> changes;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_ALARMENGINE_H
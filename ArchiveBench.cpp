@@ -0,0 +1,382 @@
+// Mission archive round trip: four channels (a jittered 1 kHz stream with
+// late samples, an int channel, one crossing zero time, and a burst larger
+// than a chunk) are written with 1 s chunk spans, closed and read back.
+// Late samples leave chunks whose starts are out of order in the file.
+// read() and minMax() over windows landing on span and chunk boundaries
+// must match a brute-force scan of what was appended, findChunks() must
+// cover every chunk holding a sample of the window, and a flipped index
+// byte must make open() fail while a flipped data byte fails verifyChunk().
+// Rollups at 1 ms, 100 ms and 1 s must give the same count/min/max/sum per
+// bucket as a brute-force grouping, after merging the duplicate buckets that
+// late samples leave behind, and chooseLevel() must pick the coarsest level
+// with at least one bucket per two pixels for each plot width.
+#include "ArchiveReader.h"
+#include "ArchiveWriter.h"
+#include "Bench.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const ArchivePath = "skylinkbench-archive.skyarc";
+        const char* const DamagedPath = "skylinkbench-archive-damaged.skyarc";
+        const std::int64_t Millisecond = 1000ll * 1000;
+        const std::int64_t Second = 1000 * Millisecond;
+        const std::int64_t Span = Second;
+        const ChannelId Channels = 4;
+        const std::size_t BatchSamples = 1000;
+        const std::vector<std::int64_t> RollupWidths = { Millisecond, 100 * Millisecond, Second };
+
+        // What was appended, in append order, plus the key it was appended by
+        struct Appended {
+            std::int64_t arrival;
+            Sample sample;
+        };
+
+        // Values are multiples of 1/16, so sums come out exact in any order
+        std::vector<Appended> missionSamples() {
+            std::vector<Appended> all;
+            // 0: 1 kHz for 30 s with jitter; every 500th sample arrives 1.5 s late
+            for (std::int64_t i = 0; i < 30000; ++i) {
+                const std::int64_t timestamp = i * Millisecond + (i * 37) % 400 * 1000;
+                const double value = static_cast<double>(i % 200 - 100) / 8.0;
+                all.push_back(Appended{ i % 500 == 7 ? timestamp + 3 * Span / 2 : timestamp,
+                    Sample::fromDouble(0, timestamp, value) });
+            }
+            // 1: int housekeeping at 10 Hz
+            for (std::int64_t i = 0; i < 300; ++i) {
+                all.push_back(Appended{ i * 100 * Millisecond, Sample::fromInt(1, i * 100 * Millisecond, i % 50) });
+            }
+            // 2: 100 Hz from -5 s to 5 s, across zero
+            for (std::int64_t i = -500; i < 500; ++i) {
+                all.push_back(Appended{ i * 10 * Millisecond,
+                    Sample::fromDouble(2, i * 10 * Millisecond, -static_cast<double>((i + 500) % 64) / 4.0) });
+            }
+            // 3: a 100 kHz burst in one span, more than MaxChunkSamples
+            for (std::int64_t i = 0; i < 100000; ++i) {
+                const std::int64_t timestamp = 12 * Second + i * 10000;
+                all.push_back(Appended{ timestamp, Sample::fromDouble(3, timestamp, static_cast<double>((i * 7) % 1000) / 16.0) });
+            }
+            std::stable_sort(all.begin(), all.end(),
+                [](const Appended& a, const Appended& b) { return a.arrival < b.arrival; });
+            return all;
+        }
+
+        bool writeArchive(const std::vector<Appended>& all) {
+            ArchiveWriter writer;
+            if (!writer.setRollupLevels(RollupWidths) || !writer.open(ArchivePath, Span)) {
+                return false;
+            }
+            std::vector<Sample> batch;
+            for (std::size_t i = 0; i < all.size(); i += BatchSamples) {
+                batch.clear();
+                for (std::size_t j = i; j < all.size() && j < i + BatchSamples; ++j) {
+                    batch.push_back(all[j].sample);
+                }
+                writer.append(SampleSpan(batch.data(), batch.size()));
+            }
+            const bool written = writer.samplesWritten() == all.size();
+            return writer.close() && written;
+        }
+
+        typedef std::vector<std::pair<std::int64_t, double>> Points;
+
+        Points bruteRead(const std::vector<Appended>& all, ChannelId channel, std::int64_t from, std::int64_t to) {
+            Points points;
+            for (const Appended& entry : all) {
+                if (entry.sample.channel == channel && entry.sample.timestamp >= from && entry.sample.timestamp <= to) {
+                    points.push_back(std::make_pair(entry.sample.timestamp, entry.sample.asDouble()));
+                }
+            }
+            std::sort(points.begin(), points.end());
+            return points;
+        }
+
+        // Windows on span starts and ends, single instants, empty stretches and whole channels
+        std::vector<std::pair<std::int64_t, std::int64_t>> windows() {
+            std::vector<std::pair<std::int64_t, std::int64_t>> result = {
+                { -100 * Second, 100 * Second }, { 0, 0 }, { 0, Span - 1 }, { Span, Span }, { Span - 1, Span },
+                { 3 * Span, 5 * Span - 1 }, { -Span, -1 }, { -Span - 1, -Span + 1 }, { -5 * Second, -5 * Second },
+                { 12 * Second, 13 * Second }, { 12 * Second + 655350000, 12 * Second + 655370000 },
+                { 29 * Second + 999 * Millisecond, 40 * Second }, { 40 * Second, 50 * Second }, { -50 * Second, -6 * Second },
+                { 7 * Span + 250 * Millisecond, 9 * Span + 750 * Millisecond }
+            };
+            for (std::int64_t start = -3 * Second; start < 31 * Second; start += 1700 * Millisecond) {
+                result.push_back(std::make_pair(start, start + 2300 * Millisecond));
+            }
+            return result;
+        }
+
+        bool sameAsBruteForce(const ArchiveReader& reader, const std::vector<Appended>& all, std::size_t& windowsChecked) {
+            bool same = true;
+            for (const std::pair<std::int64_t, std::int64_t>& window : windows()) {
+                for (ChannelId channel = 0; channel < Channels; ++channel) {
+                    const Points expected = bruteRead(all, channel, window.first, window.second);
+
+                    std::vector<std::int64_t> timestamps;
+                    std::vector<double> values;
+                    reader.read(channel, window.first, window.second, timestamps, values);
+                    Points got;
+                    for (std::size_t i = 0; i < timestamps.size(); ++i) {
+                        got.push_back(std::make_pair(timestamps[i], values[i]));
+                    }
+                    std::sort(got.begin(), got.end());
+                    same = same && got == expected;
+
+                    double min = 0.0;
+                    double max = 0.0;
+                    const bool found = reader.minMax(channel, window.first, window.second, min, max);
+                    if (expected.empty()) {
+                        same = same && !found;
+                    }
+                    else {
+                        double bruteMin = expected[0].second;
+                        double bruteMax = expected[0].second;
+                        for (const std::pair<std::int64_t, double>& point : expected) {
+                            bruteMin = std::min(bruteMin, point.second);
+                            bruteMax = std::max(bruteMax, point.second);
+                        }
+                        same = same && found && min == bruteMin && max == bruteMax;
+                    }
+
+                    // Every chunk with a sample inside the window must be in findChunks()
+                    const std::pair<std::size_t, std::size_t> covered = reader.findChunks(channel, window.first, window.second);
+                    const std::pair<std::size_t, std::size_t> channelRange = reader.channelChunks(channel);
+                    for (std::size_t i = channelRange.first; i < channelRange.second; ++i) {
+                        const ArchiveReader::ChunkView chunk = reader.view(i);
+                        bool inside = false;
+                        for (std::size_t j = 0; j < chunk.count && !inside; ++j) {
+                            inside = chunk.timestamps[j] >= window.first && chunk.timestamps[j] <= window.second;
+                        }
+                        same = same && (!inside || (i >= covered.first && i < covered.second));
+                    }
+                    ++windowsChecked;
+                }
+            }
+            return same;
+        }
+
+        std::int64_t floorTo(std::int64_t timestamp, std::int64_t width) {
+            const std::int64_t start = timestamp / width * width;
+            return start > timestamp ? start - width : start;
+        }
+
+        // Buckets of width overlapping [from, to], grouped straight from what was appended
+        std::vector<RollupBucket> bruteBuckets(const std::vector<Appended>& all, ChannelId channel, std::int64_t width,
+            std::int64_t from, std::int64_t to) {
+            std::vector<RollupBucket> buckets;
+            for (const Appended& entry : all) {
+                const std::int64_t start = floorTo(entry.sample.timestamp, width);
+                if (entry.sample.channel != channel || start > to || start + width <= from) {
+                    continue;
+                }
+                const double value = entry.sample.asDouble();
+                buckets.push_back(RollupBucket{ start, 1, 0, value, value, value });
+            }
+            std::sort(buckets.begin(), buckets.end(),
+                [](const RollupBucket& a, const RollupBucket& b) { return a.start < b.start; });
+            std::size_t write = 0;
+            for (std::size_t read = 0; read < buckets.size(); ++read) {
+                if (write > 0 && buckets[write - 1].start == buckets[read].start) {
+                    RollupBucket& merged = buckets[write - 1];
+                    merged.count += 1;
+                    merged.min = std::min(merged.min, buckets[read].min);
+                    merged.max = std::max(merged.max, buckets[read].max);
+                    merged.sum += buckets[read].sum;
+                }
+                else {
+                    buckets[write++] = buckets[read];
+                }
+            }
+            buckets.resize(write);
+            return buckets;
+        }
+
+        bool sameBuckets(const std::vector<RollupBucket>& a, const std::vector<RollupBucket>& b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                // Values are multiples of 1/16, so the sums (and means) must agree exactly
+                if (a[i].start != b[i].start || a[i].count != b[i].count || a[i].min != b[i].min ||
+                    a[i].max != b[i].max || a[i].sum != b[i].sum) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool rollupsMatch(const ArchiveReader& reader, const std::vector<Appended>& all, std::size_t& queries) {
+            bool same = reader.rollupLevels() == RollupWidths.size();
+            for (std::uint32_t level = 1; level <= reader.rollupLevels() && same; ++level) {
+                same = reader.rollupWidth(level) == RollupWidths[level - 1];
+            }
+            for (const std::pair<std::int64_t, std::int64_t>& window : windows()) {
+                for (ChannelId channel = 0; channel < Channels && same; ++channel) {
+                    for (std::uint32_t level = 1; level <= reader.rollupLevels(); ++level) {
+                        std::vector<RollupBucket> got;
+                        reader.readBuckets(channel, level, window.first, window.second, got);
+                        same = same && sameBuckets(got,
+                            bruteBuckets(all, channel, reader.rollupWidth(level), window.first, window.second));
+                        ++queries;
+                    }
+                }
+            }
+            return same;
+        }
+
+        // Buckets of channel at level stored more than once, which only late samples cause
+        std::size_t duplicateBuckets(const ArchiveReader& reader, ChannelId channel, std::uint32_t level) {
+            std::vector<std::int64_t> starts;
+            const std::pair<std::size_t, std::size_t> range = reader.channelChunks(channel, level);
+            for (std::size_t i = range.first; i < range.second; ++i) {
+                const RollupBucket* bucket = reader.buckets(i);
+                for (std::uint32_t j = 0; j < reader.chunk(i).count; ++j) {
+                    starts.push_back(bucket[j].start);
+                }
+            }
+            std::sort(starts.begin(), starts.end());
+            return static_cast<std::size_t>(starts.end() - std::unique(starts.begin(), starts.end()));
+        }
+
+        // chooseLevel() against the rule it promises, and query() against readBuckets() at that level
+        bool levelsChosen(const ArchiveReader& reader, std::size_t& choices) {
+            const std::pair<std::int64_t, std::int64_t> ranges[] = {
+                { -5 * Second, 30 * Second }, { 0, Second }, { 12 * Second, 12 * Second + 10 * Millisecond }, { 0, 0 }
+            };
+            const std::size_t pixelWidths[] = { 0, 1, 10, 100, 1000, 1920, 100000 };
+            bool right = true;
+            for (const std::pair<std::int64_t, std::int64_t>& range : ranges) {
+                for (std::size_t pixels : pixelWidths) {
+                    const std::int64_t perPixel = (range.second - range.first) / static_cast<std::int64_t>(pixels ? pixels : 1);
+                    std::uint32_t expected = 0;
+                    for (std::int64_t width : RollupWidths) {
+                        expected += width <= 2 * perPixel ? 1 : 0;
+                    }
+                    std::vector<RollupBucket> queried;
+                    std::vector<RollupBucket> direct;
+                    const std::uint32_t level = reader.query(0, range.first, range.second, pixels, queried);
+                    reader.readBuckets(0, expected, range.first, range.second, direct);
+                    right = right && reader.chooseLevel(range.first, range.second, pixels) == expected &&
+                        level == expected && sameBuckets(queried, direct);
+                    ++choices;
+                }
+            }
+            return right;
+        }
+
+        // Chunk starts in file order going backwards, which only late samples cause
+        std::size_t outOfOrderStarts(const std::string& path) {
+            MappedFile file;
+            if (!file.openReadOnly(path)) {
+                return 0;
+            }
+            ArchiveFooter footer;
+            std::memcpy(&footer, file.data() + file.size() - sizeof(footer), sizeof(footer));
+            std::vector<std::int64_t> previous(Channels, std::numeric_limits<std::int64_t>::min());
+            std::size_t backwards = 0;
+            for (std::uint64_t i = 0; i < footer.entryCount; ++i) {
+                ChunkIndexEntry entry;
+                std::memcpy(&entry, file.data() + footer.indexOffset + i * sizeof(entry), sizeof(entry));
+                if (entry.level != 0 || entry.channel >= Channels) {
+                    continue;
+                }
+                if (entry.firstTimestamp < previous[entry.channel]) {
+                    ++backwards;
+                }
+                previous[entry.channel] = entry.firstTimestamp;
+            }
+            return backwards;
+        }
+
+        // Copies the archive with one byte flipped at offset from the start (or, if negative, from the end)
+        bool writeDamaged(std::int64_t offset) {
+            std::ifstream in(ArchivePath, std::ios::binary);
+            std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            const std::int64_t at = offset >= 0 ? offset : static_cast<std::int64_t>(bytes.size()) + offset;
+            if (at < 0 || at >= static_cast<std::int64_t>(bytes.size())) {
+                return false;
+            }
+            bytes[static_cast<std::size_t>(at)] ^= 0x10;
+            std::ofstream out(DamagedPath, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            return static_cast<bool>(out);
+        }
+
+    } // namespace
+
+    bool benchArchive() {
+        const std::vector<Appended> all = missionSamples();
+        if (!writeArchive(all)) {
+            MappedFile::remove(ArchivePath);
+            return false;
+        }
+
+        ArchiveReader reader;
+        if (!reader.open(ArchivePath)) {
+            MappedFile::remove(ArchivePath);
+            return false;
+        }
+        std::size_t rawChunks = 0;
+        std::size_t rawSamples = 0;
+        bool chunksIntact = true;
+        for (std::size_t i = 0; i < reader.chunkCount(); ++i) {
+            chunksIntact = chunksIntact && reader.verifyChunk(i);
+            if (reader.chunk(i).level == 0) {
+                ++rawChunks;
+                rawSamples += reader.chunk(i).count;
+            }
+        }
+        const std::vector<ChannelId> channels = reader.channels();
+        const bool complete = rawSamples == all.size() && chunksIntact &&
+            channels == std::vector<ChannelId>{ 0, 1, 2, 3 };
+        const std::size_t backwards = outOfOrderStarts(ArchivePath);
+
+        std::size_t windowsChecked = 0;
+        const bool matches = sameAsBruteForce(reader, all, windowsChecked);
+        std::size_t bucketQueries = 0;
+        const bool rollups = rollupsMatch(reader, all, bucketQueries);
+        const std::size_t duplicates = duplicateBuckets(reader, 0, 2);
+        std::size_t choices = 0;
+        const bool chosen = levelsChosen(reader, choices);
+
+        // Index bytes sit just before the footer; the first chunk right after the header
+        const bool indexRejected = writeDamaged(-static_cast<std::int64_t>(sizeof(ArchiveFooter) + 20)) &&
+            !ArchiveReader().open(DamagedPath);
+        bool dataCaught = false;
+        if (writeDamaged(static_cast<std::int64_t>(sizeof(ArchiveHeader) + 3))) {
+            ArchiveReader damaged;
+            if (damaged.open(DamagedPath)) {
+                std::size_t bad = 0;
+                for (std::size_t i = 0; i < damaged.chunkCount(); ++i) {
+                    bad += damaged.verifyChunk(i) ? 0 : 1;
+                }
+                dataCaught = bad == 1;
+            }
+        }
+        reader.close();
+        MappedFile::remove(DamagedPath);
+        MappedFile::remove(ArchivePath);
+
+        std::printf("%zu samples in %zu raw chunks, %zu chunk starts out of file order; all read back: %s\n",
+            rawSamples, rawChunks, backwards, complete ? "yes" : "no");
+        std::printf("read, minMax and findChunks match brute force over %zu channel windows: %s; "
+            "corrupt index rejected: %s, corrupt chunk caught: %s\n", windowsChecked, matches ? "yes" : "no",
+            indexRejected ? "yes" : "no", dataCaught ? "yes" : "no");
+        std::printf("rollups match brute force over %zu bucket queries (%zu duplicate 100 ms buckets merged): %s; "
+            "chooseLevel right for %zu plot widths: %s\n", bucketQueries, duplicates, rollups ? "yes" : "no",
+            choices, chosen ? "yes" : "no");
+        return complete && backwards > 0 && matches && indexRejected && dataCaught && rollups && duplicates > 0 && chosen;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,81 @@
+#ifndef SKYLINE_ARCHIVEFORMAT_H
+#define SKYLINE_ARCHIVEFORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    // On-disk layout of a columnar mission archive (little-endian):
+    //
+    //   ArchiveHeader | chunk | chunk | ... | ChunkIndexEntry[entryCount] | ArchiveFooter
+    //
+    // A chunk holds one channel over one fixed time span as two columns,
+    // count int64 timestamps followed by count doubles. The index at the end
+    // lets a reader map the file and touch only the chunks a query needs.
+    //
+    // Version 2 adds rollup chunks: index entries with level > 0 whose data is
+    // an array of RollupBucket, one per rollupWidths[level - 1] interval with
+    // samples. Zoomed-out plots read these instead of the raw columns.
+
+    const char ArchiveMagic[8] = { 'S', 'K', 'Y', 'L', 'A', 'R', 'C', '1' };
+    const std::uint32_t ArchiveVersion = 2;
+    const std::uint32_t MaxRollupLevels = 3;
+
+    struct ArchiveHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::int64_t chunkSpan;      // nanoseconds covered by one chunk
+        std::int64_t createdAt;      // nanoseconds
+        std::uint32_t rollupLevels;  // 0 in version 1 files
+        std::uint32_t reserved;
+        std::int64_t rollupWidths[MaxRollupLevels]; // nanoseconds, finest first
+    };
+
+    struct ChunkIndexEntry {
+        std::uint32_t channel;
+        std::uint8_t type;           // SampleType of the samples, Int only if all were Int
+        std::uint8_t level;          // 0: raw columns, n: rollup buckets of rollupWidths[n - 1]
+        std::uint8_t reserved[2];
+        std::uint32_t count;         // samples, or buckets for rollup chunks
+        std::uint32_t crc;           // CRC-32 of the chunk data
+        std::uint64_t offset;        // of the timestamp column or bucket array
+        std::int64_t firstTimestamp;
+        std::int64_t lastTimestamp;
+        double minValue;
+        double maxValue;
+        double sum;
+    };
+
+    struct RollupBucket {
+        std::int64_t start;
+        std::uint32_t count;
+        std::uint32_t reserved;
+        double min;
+        double max;
+        double sum;
+    };
+
+    struct ArchiveFooter {
+        std::uint64_t indexOffset;
+        std::uint64_t entryCount;
+        std::uint32_t indexCrc;
+        std::uint32_t reserved;
+        char magic[8];
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 64, "ArchiveHeader layout changed");
+    static_assert(sizeof(ChunkIndexEntry) == 64, "ChunkIndexEntry layout changed");
+    static_assert(sizeof(ArchiveFooter) == 32, "ArchiveFooter layout changed");
+    static_assert(sizeof(RollupBucket) == 40, "RollupBucket layout changed");
+
+    inline bool isArchiveHeader(const ArchiveHeader& header) {
+        return std::memcmp(header.magic, ArchiveMagic, sizeof(ArchiveMagic)) == 0 &&
+            header.version >= 1 && header.version <= ArchiveVersion;
+    }
+
+} // namespace SkyLine
+
+#endif // SKYLINE_ARCHIVEFORMAT_H
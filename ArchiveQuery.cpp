@@ -0,0 +1,194 @@
+#include "ArchiveQuery.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKYLINK_QUERY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace SkyLink {
+
+    namespace {
+
+        // Min, max and sum of values[0, count)
+        void reduceValues(const double* values, std::size_t count, double& min, double& max, double& sum) {
+            std::size_t i = 0;
+#ifdef SKYLINK_QUERY_SSE2
+            if (count >= 4) {
+                __m128d vmin = _mm_set1_pd(min);
+                __m128d vmax = _mm_set1_pd(max);
+                __m128d vsum0 = _mm_setzero_pd();
+                __m128d vsum1 = _mm_setzero_pd();
+                for (; i + 4 <= count; i += 4) {
+                    const __m128d a = _mm_loadu_pd(values + i);
+                    const __m128d b = _mm_loadu_pd(values + i + 2);
+                    vmin = _mm_min_pd(vmin, _mm_min_pd(a, b));
+                    vmax = _mm_max_pd(vmax, _mm_max_pd(a, b));
+                    vsum0 = _mm_add_pd(vsum0, a);
+                    vsum1 = _mm_add_pd(vsum1, b);
+                }
+                double lanes[2];
+                _mm_storeu_pd(lanes, vmin);
+                min = std::min(lanes[0], lanes[1]);
+                _mm_storeu_pd(lanes, vmax);
+                max = std::max(lanes[0], lanes[1]);
+                _mm_storeu_pd(lanes, _mm_add_pd(vsum0, vsum1));
+                sum += lanes[0] + lanes[1];
+            }
+#endif
+            for (; i < count; ++i) {
+                min = std::min(min, values[i]);
+                max = std::max(max, values[i]);
+                sum += values[i];
+            }
+        }
+
+    } // namespace
+
+    ArchiveQuery::ArchiveQuery(ThreadPool& pool)
+        : pool(pool) {}
+
+    void ArchiveQuery::addArchive(const ArchiveReader* archive) {
+        archives.push_back(archive);
+    }
+
+    void ArchiveQuery::clearArchives() {
+        archives.clear();
+    }
+
+    std::vector<AggregateResult> ArchiveQuery::run(const std::vector<AggregateRequest>& requests) {
+        // Tasks are generated request by request, archive by archive, chunk by chunk
+        // in time order; the merge below relies on that order.
+        tasks.clear();
+        for (std::uint32_t r = 0; r < requests.size(); ++r) {
+            for (std::uint32_t a = 0; a < archives.size(); ++a) {
+                const std::pair<std::size_t, std::size_t> range =
+                    archives[a]->findChunks(requests[r].channel, requests[r].from, requests[r].to);
+                for (std::size_t chunk = range.first; chunk < range.second; ++chunk) {
+                    tasks.push_back(Task{ r, a, chunk });
+                }
+            }
+        }
+        partials.resize(tasks.size());
+
+        pool.parallelFor(tasks.size(), [this, &requests](std::size_t i, unsigned) {
+            reduceChunk(tasks[i], requests[tasks[i].request], partials[i]);
+        });
+
+        std::vector<AggregateResult> results(requests.size());
+        for (std::size_t r = 0; r < requests.size(); ++r) {
+            results[r].histogram.assign(requests[r].histogramBins, 0);
+        }
+        std::size_t previous = tasks.size(); // last task with samples
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const Partial& partial = partials[i];
+            if (partial.result.count == 0) {
+                continue;
+            }
+            AggregateResult& result = results[tasks[i].request];
+            if (previous != tasks.size() && tasks[previous].request == tasks[i].request &&
+                tasks[previous].archive == tasks[i].archive && partials[previous].lastAbove &&
+                partial.firstTimestamp > partials[previous].lastTimestamp) {
+                // Hold the previous chunk's last value until this chunk's first sample
+                result.timeAbove += partial.firstTimestamp - partials[previous].lastTimestamp;
+            }
+            result.count += partial.result.count;
+            result.min = std::min(result.min, partial.result.min);
+            result.max = std::max(result.max, partial.result.max);
+            result.sum += partial.result.sum;
+            result.timeAbove += partial.result.timeAbove;
+            for (std::size_t bin = 0; bin < partial.result.histogram.size(); ++bin) {
+                result.histogram[bin] += partial.result.histogram[bin];
+            }
+            previous = i;
+        }
+        return results;
+    }
+
+    void ArchiveQuery::reduceChunk(const Task& task, const AggregateRequest& request, Partial& partial) const {
+        const ArchiveReader& archive = *archives[task.archive];
+        const ChunkIndexEntry& entry = archive.chunk(task.chunk);
+        const bool whole = entry.firstTimestamp >= request.from && entry.lastTimestamp <= request.to;
+        const bool wantThreshold = !std::isnan(request.threshold);
+        const bool wantHistogram = request.histogramBins > 0 && request.histogramMax > request.histogramMin;
+
+        partial = Partial();
+        AggregateResult& result = partial.result;
+        result.histogram.assign(wantHistogram ? request.histogramBins : 0, 0);
+
+        if (whole && !wantThreshold && !wantHistogram) {
+            // Everything needed is already in the index; the chunk data is never touched
+            result.count = entry.count;
+            result.min = entry.minValue;
+            result.max = entry.maxValue;
+            result.sum = entry.sum;
+            partial.firstTimestamp = entry.firstTimestamp;
+            partial.lastTimestamp = entry.lastTimestamp;
+            partial.lastAbove = false;
+            return;
+        }
+
+        const ArchiveReader::ChunkView chunk = archive.view(task.chunk);
+        const std::int64_t* t = chunk.timestamps;
+        const double* v = chunk.values;
+        const std::size_t count = chunk.count;
+        const double threshold = request.threshold;
+        const double histogramScale = wantHistogram ?
+            request.histogramBins / (request.histogramMax - request.histogramMin) : 0.0;
+
+        if (whole) {
+            result.count = count;
+            reduceValues(v, count, result.min, result.max, result.sum);
+            partial.firstTimestamp = t[0];
+            partial.lastTimestamp = t[count - 1];
+            if (wantThreshold) {
+                std::int64_t above = 0;
+                for (std::size_t i = 0; i + 1 < count; ++i) {
+                    const std::int64_t gap = t[i + 1] - t[i];
+                    above += (v[i] > threshold && gap > 0) ? gap : 0;
+                }
+                result.timeAbove = above;
+                partial.lastAbove = v[count - 1] > threshold;
+            }
+        }
+        else {
+            // Edge chunk: filter sample by sample, late samples may leave it out of order
+            std::size_t previous = count;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (t[i] < request.from || t[i] > request.to) {
+                    continue;
+                }
+                if (result.count == 0) {
+                    partial.firstTimestamp = t[i];
+                }
+                ++result.count;
+                result.min = std::min(result.min, v[i]);
+                result.max = std::max(result.max, v[i]);
+                result.sum += v[i];
+                if (wantThreshold && previous != count && v[previous] > threshold && t[i] > t[previous]) {
+                    result.timeAbove += t[i] - t[previous];
+                }
+                previous = i;
+            }
+            if (result.count == 0) {
+                return;
+            }
+            partial.lastTimestamp = t[previous];
+            partial.lastAbove = wantThreshold && v[previous] > threshold;
+        }
+
+        if (wantHistogram) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!whole && (t[i] < request.from || t[i] > request.to)) {
+                    continue;
+                }
+                const double position = (v[i] - request.histogramMin) * histogramScale;
+                if (position >= 0.0 && position < request.histogramBins) {
+                    ++result.histogram[static_cast<std::size_t>(position)];
+                }
+            }
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,75 @@
+#ifndef SKYLINE_ARCHIVEQUERY_H
+#define SKYLINE_ARCHIVEQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "ArchiveReader.h"
+#include "ThreadPool.h"
+
+namespace SkyLink {
+
+    struct AggregateRequest {
+        ChannelId channel;
+        std::int64_t from;
+        std::int64_t to;
+        // Time above threshold, sample-and-hold between samples; NaN disables it
+        double threshold = std::numeric_limits<double>::quiet_NaN();
+        // Histogram over [histogramMin, histogramMax); 0 bins disables it
+        std::uint32_t histogramBins = 0;
+        double histogramMin = 0.0;
+        double histogramMax = 0.0;
+    };
+
+    struct AggregateResult {
+        std::uint64_t count = 0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        double sum = 0.0;
+        std::int64_t timeAbove = 0; // nanoseconds
+        std::vector<std::uint64_t> histogram; // values outside the range are not counted
+
+        double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    // Runs aggregate requests over one or more archives (e.g. every recorded
+    // flight). Each request is split into one task per overlapping chunk;
+    // tasks reduce their chunk independently on the pool and the partial
+    // results are merged per request in time order, so answers do not depend
+    // on the thread count.
+    class ArchiveQuery {
+    public:
+        explicit ArchiveQuery(ThreadPool& pool);
+
+        void addArchive(const ArchiveReader* archive);
+        void clearArchives();
+
+        // One result per request, summed over all archives
+        std::vector<AggregateResult> run(const std::vector<AggregateRequest>& requests);
+
+    private:
+        struct Task {
+            std::uint32_t request;
+            std::uint32_t archive;
+            std::size_t chunk;
+        };
+
+        struct Partial {
+            AggregateResult result;
+            std::int64_t firstTimestamp; // of the first/last sample inside the range
+            std::int64_t lastTimestamp;
+            bool lastAbove;
+        };
+
+        void reduceChunk(const Task& task, const AggregateRequest& request, Partial& partial) const;
+
+        ThreadPool& pool;
+        std::vector<const ArchiveReader*> archives;
+        std::vector<Task> tasks;
+        std::vector<Partial> partials;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_ARCHIVEQUERY_H
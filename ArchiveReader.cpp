@@ -0,0 +1,273 @@
+#include "ArchiveReader.h"
+#include "Crc32.h"
+#include <algorithm>
+#include <iostream>
+
+namespace SkyLink {
+
+    bool ArchiveReader::open(const std::string& path) {
+        close();
+        if (!file.openReadOnly(path)) {
+            return false;
+        }
+        const std::uint8_t* data = file.data();
+        const std::size_t size = file.size();
+
+        ArchiveHeader header;
+        ArchiveFooter footer;
+        if (size < sizeof(ArchiveHeader) + sizeof(ArchiveFooter)) {
+            std::cerr << "ERROR::ARCHIVEREADER::File too small: " << path << std::endl;
+            close();
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        std::memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+        if (!isArchiveHeader(header) || std::memcmp(footer.magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0) {
+            std::cerr << "ERROR::ARCHIVEREADER::Not an archive or not closed properly: " << path << std::endl;
+            close();
+            return false;
+        }
+        const std::uint64_t indexBytes = footer.entryCount * sizeof(ChunkIndexEntry);
+        if (footer.indexOffset + indexBytes + sizeof(footer) != size ||
+            crc32(data + footer.indexOffset, static_cast<std::size_t>(indexBytes)) != footer.indexCrc) {
+            std::cerr << "ERROR::ARCHIVEREADER::Corrupt index in " << path << std::endl;
+            close();
+            return false;
+        }
+
+        span = header.chunkSpan;
+        levels = header.version >= 2 ? header.rollupLevels : 0;
+        if (levels > MaxRollupLevels) {
+            std::cerr << "ERROR::ARCHIVEREADER::Bad rollup level count in " << path << std::endl;
+            close();
+            return false;
+        }
+        for (std::uint32_t level = 0; level < levels; ++level) {
+            widths[level] = header.rollupWidths[level];
+        }
+        index.resize(static_cast<std::size_t>(footer.entryCount));
+        std::memcpy(index.data(), data + footer.indexOffset, static_cast<std::size_t>(indexBytes));
+        for (ChunkIndexEntry& entry : index) {
+            if (header.version < 2) {
+                entry.level = 0;
+            }
+            const std::uint64_t dataBytes = static_cast<std::uint64_t>(entry.count) *
+                (entry.level == 0 ? 16 : sizeof(RollupBucket));
+            if (entry.level > levels || entry.offset % 8 != 0 || entry.offset + dataBytes > footer.indexOffset) {
+                std::cerr << "ERROR::ARCHIVEREADER::Chunk outside the data area in " << path << std::endl;
+                close();
+                return false;
+            }
+        }
+
+        std::stable_sort(index.begin(), index.end(), [](const ChunkIndexEntry& a, const ChunkIndexEntry& b) {
+            if (a.channel != b.channel) {
+                return a.channel < b.channel;
+            }
+            return a.level != b.level ? a.level < b.level : a.firstTimestamp < b.firstTimestamp;
+            });
+        for (std::size_t i = 0; i < index.size(); ++i) {
+            const std::size_t slot = static_cast<std::size_t>(index[i].channel) * LevelSlots + index[i].level;
+            if (slot >= channelRanges.size()) {
+                channelRanges.resize((static_cast<std::size_t>(index[i].channel) + 1) * LevelSlots, std::make_pair(i, i));
+            }
+            if (channelRanges[slot].first == channelRanges[slot].second) {
+                channelRanges[slot].first = i;
+            }
+            channelRanges[slot].second = i + 1;
+        }
+        return true;
+    }
+
+    void ArchiveReader::close() {
+        file.close();
+        index.clear();
+        channelRanges.clear();
+        span = 0;
+        levels = 0;
+    }
+
+    ArchiveReader::ChunkView ArchiveReader::view(std::size_t i) const {
+        const ChunkIndexEntry& entry = index[i];
+        const std::uint8_t* column = file.data() + entry.offset;
+        ChunkView chunkView;
+        chunkView.timestamps = reinterpret_cast<const std::int64_t*>(column);
+        chunkView.values = reinterpret_cast<const double*>(column + entry.count * sizeof(std::int64_t));
+        chunkView.count = entry.count;
+        return chunkView;
+    }
+
+    const RollupBucket* ArchiveReader::buckets(std::size_t i) const {
+        return reinterpret_cast<const RollupBucket*>(file.data() + index[i].offset);
+    }
+
+    bool ArchiveReader::verifyChunk(std::size_t i) const {
+        const ChunkIndexEntry& entry = index[i];
+        const std::size_t dataBytes = entry.count * (entry.level == 0 ? 16 : sizeof(RollupBucket));
+        return crc32(file.data() + entry.offset, dataBytes) == entry.crc;
+    }
+
+    std::vector<ChannelId> ArchiveReader::channels() const {
+        std::vector<ChannelId> result;
+        for (std::size_t slot = 0; slot < channelRanges.size(); slot += LevelSlots) {
+            if (channelRanges[slot].first != channelRanges[slot].second) {
+                result.push_back(static_cast<ChannelId>(slot / LevelSlots));
+            }
+        }
+        return result;
+    }
+
+    std::pair<std::size_t, std::size_t> ArchiveReader::channelChunks(ChannelId channel, std::uint32_t level) const {
+        const std::size_t slot = static_cast<std::size_t>(channel) * LevelSlots + level;
+        if (level >= LevelSlots || slot >= channelRanges.size()) {
+            return std::make_pair(std::size_t(0), std::size_t(0));
+        }
+        return channelRanges[slot];
+    }
+
+    std::pair<std::size_t, std::size_t> ArchiveReader::findChunks(ChannelId channel, std::int64_t from, std::int64_t to) const {
+        const std::pair<std::size_t, std::size_t> range = channelChunks(channel);
+        auto first = index.begin() + range.first;
+        auto last = index.begin() + range.second;
+
+        // Chunks start in time order; a chunk starting after 'to' and everything behind it is out
+        last = std::upper_bound(first, last, to,
+            [](std::int64_t value, const ChunkIndexEntry& entry) { return value < entry.firstTimestamp; });
+        // A chunk never crosses its span boundary, so chunks starting before the
+        // span that holds 'from' cannot reach it. Late samples can make chunks of
+        // the same span overlap, which is why this does not search on lastTimestamp.
+        std::int64_t spanStart = from;
+        if (span > 0) {
+            spanStart = from / span * span;
+            if (spanStart > from) {
+                spanStart -= span;
+            }
+        }
+        first = std::lower_bound(first, last, spanStart,
+            [](const ChunkIndexEntry& entry, std::int64_t value) { return entry.firstTimestamp < value; });
+        return std::make_pair(static_cast<std::size_t>(first - index.begin()), static_cast<std::size_t>(last - index.begin()));
+    }
+
+    std::size_t ArchiveReader::read(ChannelId channel, std::int64_t from, std::int64_t to,
+        std::vector<std::int64_t>& timestamps, std::vector<double>& values) const {
+        const std::size_t before = timestamps.size();
+        const std::pair<std::size_t, std::size_t> range = findChunks(channel, from, to);
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            const ChunkView chunkView = view(i);
+            const ChunkIndexEntry& entry = index[i];
+            if (entry.firstTimestamp >= from && entry.lastTimestamp <= to) {
+                timestamps.insert(timestamps.end(), chunkView.timestamps, chunkView.timestamps + chunkView.count);
+                values.insert(values.end(), chunkView.values, chunkView.values + chunkView.count);
+                continue;
+            }
+            for (std::size_t j = 0; j < chunkView.count; ++j) {
+                if (chunkView.timestamps[j] >= from && chunkView.timestamps[j] <= to) {
+                    timestamps.push_back(chunkView.timestamps[j]);
+                    values.push_back(chunkView.values[j]);
+                }
+            }
+        }
+        return timestamps.size() - before;
+    }
+
+    bool ArchiveReader::minMax(ChannelId channel, std::int64_t from, std::int64_t to, double& min, double& max) const {
+        bool found = false;
+        const std::pair<std::size_t, std::size_t> range = findChunks(channel, from, to);
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            const ChunkIndexEntry& entry = index[i];
+            if (entry.firstTimestamp >= from && entry.lastTimestamp <= to) {
+                min = found ? std::min(min, entry.minValue) : entry.minValue;
+                max = found ? std::max(max, entry.maxValue) : entry.maxValue;
+                found = true;
+                continue;
+            }
+            const ChunkView chunkView = view(i);
+            for (std::size_t j = 0; j < chunkView.count; ++j) {
+                if (chunkView.timestamps[j] >= from && chunkView.timestamps[j] <= to) {
+                    const double value = chunkView.values[j];
+                    min = found ? std::min(min, value) : value;
+                    max = found ? std::max(max, value) : value;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    std::uint32_t ArchiveReader::chooseLevel(std::int64_t from, std::int64_t to, std::size_t pixels) const {
+        if (pixels == 0) {
+            pixels = 1;
+        }
+        // Up to two pixels per bucket still draws smoothly and avoids reading raw
+        // samples that are many times denser than the screen
+        const std::int64_t perPixel = (to - from) / static_cast<std::int64_t>(pixels);
+        std::uint32_t level = 0;
+        while (level < levels && widths[level] <= 2 * perPixel) {
+            ++level;
+        }
+        return level;
+    }
+
+    std::uint32_t ArchiveReader::query(ChannelId channel, std::int64_t from, std::int64_t to, std::size_t pixels,
+        std::vector<RollupBucket>& out) const {
+        const std::uint32_t level = chooseLevel(from, to, pixels);
+        readBuckets(channel, level, from, to, out);
+        return level;
+    }
+
+    void ArchiveReader::readBuckets(ChannelId channel, std::uint32_t level, std::int64_t from, std::int64_t to,
+        std::vector<RollupBucket>& out) const {
+        if (level == 0) {
+            const std::pair<std::size_t, std::size_t> range = findChunks(channel, from, to);
+            for (std::size_t i = range.first; i < range.second; ++i) {
+                const ChunkView chunkView = view(i);
+                for (std::size_t j = 0; j < chunkView.count; ++j) {
+                    if (chunkView.timestamps[j] >= from && chunkView.timestamps[j] <= to) {
+                        const double value = chunkView.values[j];
+                        out.push_back(RollupBucket{ chunkView.timestamps[j], 1, 0, value, value, value });
+                    }
+                }
+            }
+            return;
+        }
+
+        // Rollup chunks are few (thousands of buckets each), so walk them linearly
+        const std::size_t first = out.size();
+        const std::int64_t width = widths[level - 1];
+        const std::pair<std::size_t, std::size_t> range = channelChunks(channel, level);
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            const ChunkIndexEntry& entry = index[i];
+            if (entry.firstTimestamp > to) {
+                break;
+            }
+            if (entry.lastTimestamp < from) {
+                continue;
+            }
+            const RollupBucket* bucket = buckets(i);
+            for (std::uint32_t j = 0; j < entry.count; ++j) {
+                if (bucket[j].start <= to && bucket[j].start + width > from) {
+                    out.push_back(bucket[j]);
+                }
+            }
+        }
+
+        // Late samples can leave two buckets for one interval: sort and merge them
+        std::sort(out.begin() + first, out.end(),
+            [](const RollupBucket& a, const RollupBucket& b) { return a.start < b.start; });
+        std::size_t write = first;
+        for (std::size_t read = first; read < out.size(); ++read) {
+            if (write > first && out[write - 1].start == out[read].start) {
+                RollupBucket& merged = out[write - 1];
+                merged.count += out[read].count;
+                merged.min = std::min(merged.min, out[read].min);
+                merged.max = std::max(merged.max, out[read].max);
+                merged.sum += out[read].sum;
+            }
+            else {
+                out[write++] = out[read];
+            }
+        }
+        out.resize(write);
+    }
+
+} // namespace SkyLine
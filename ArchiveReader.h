@@ -0,0 +1,75 @@
+#ifndef SKYLINE_ARCHIVEREADER_H
+#define SKYLINE_ARCHIVEREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ArchiveFormat.h"
+#include "MappedFile.h"
+
+namespace SkyLink {
+
+    // Read side of the columnar archive. The file is mapped read-only and
+    // only the index is parsed up front; chunk columns are handed out as
+    // pointers into the mapping, so a query touches just the pages it reads.
+    // query() answers plot requests from the coarsest rollup level that still
+    // gives about one bucket per pixel.
+    class ArchiveReader {
+    public:
+        struct ChunkView {
+            const std::int64_t* timestamps;
+            const double* values;
+            std::size_t count;
+        };
+
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return file.isOpen(); }
+
+        std::int64_t chunkSpan() const { return span; }
+        std::uint32_t rollupLevels() const { return levels; }
+        std::int64_t rollupWidth(std::uint32_t level) const { return level == 0 ? 0 : widths[level - 1]; }
+        std::size_t chunkCount() const { return index.size(); }
+        const ChunkIndexEntry& chunk(std::size_t i) const { return index[i]; }
+        ChunkView view(std::size_t i) const;              // level 0 chunks
+        const RollupBucket* buckets(std::size_t i) const; // level > 0 chunks, chunk(i).count entries
+        bool verifyChunk(std::size_t i) const;
+
+        // Channels present in the archive, ascending
+        std::vector<ChannelId> channels() const;
+        // [first, last) chunk indices of a channel at a level, ordered by start time
+        std::pair<std::size_t, std::size_t> channelChunks(ChannelId channel, std::uint32_t level = 0) const;
+        // Chunks of channel that overlap [from, to]
+        std::pair<std::size_t, std::size_t> findChunks(ChannelId channel, std::int64_t from, std::int64_t to) const;
+
+        // Copies the samples of channel inside [from, to]; returns how many were added
+        std::size_t read(ChannelId channel, std::int64_t from, std::int64_t to,
+            std::vector<std::int64_t>& timestamps, std::vector<double>& values) const;
+        // Min/max over [from, to]; whole chunks come from the index, only edge chunks are scanned
+        bool minMax(ChannelId channel, std::int64_t from, std::int64_t to, double& min, double& max) const;
+
+        // Coarsest level with at least one bucket per two pixels over [from, to], 0 for raw
+        std::uint32_t chooseLevel(std::int64_t from, std::int64_t to, std::size_t pixels) const;
+        // Buckets of channel overlapping [from, to] in time order, from chooseLevel();
+        // at level 0 every raw sample becomes a one-sample bucket. Returns the level used.
+        std::uint32_t query(ChannelId channel, std::int64_t from, std::int64_t to, std::size_t pixels,
+            std::vector<RollupBucket>& out) const;
+        void readBuckets(ChannelId channel, std::uint32_t level, std::int64_t from, std::int64_t to,
+            std::vector<RollupBucket>& out) const;
+
+    private:
+        MappedFile file;
+        static const std::uint32_t LevelSlots = MaxRollupLevels + 1;
+
+        std::int64_t span = 0;
+        std::uint32_t levels = 0;
+        std::int64_t widths[MaxRollupLevels] = {};
+        std::vector<ChunkIndexEntry> index; // sorted by channel, level, then firstTimestamp
+        std::vector<std::pair<std::size_t, std::size_t>> channelRanges; // [channel * LevelSlots + level]
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_ARCHIVEREADER_H
@@ -0,0 +1,252 @@
+#include "ArchiveWriter.h"
+#include "Crc32.h"
+#include "RecordingReader.h"
+#include <algorithm>
+#include <iostream>
+
+namespace SkyLink {
+
+    ArchiveWriter::ArchiveWriter()
+        : span(DefaultChunkSpan), offset(0), samples(0), failed(false) {
+        const std::int64_t second = 1000ll * 1000 * 1000;
+        rollupWidths = { second, 10 * second, 60 * second };
+    }
+
+    ArchiveWriter::~ArchiveWriter() {
+        close();
+    }
+
+    bool ArchiveWriter::open(const std::string& path, std::int64_t chunkSpan) {
+        close();
+        if (chunkSpan <= 0) {
+            std::cerr << "ERROR::ARCHIVEWRITER::Chunk span must be positive" << std::endl;
+            return false;
+        }
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "ERROR::ARCHIVEWRITER::Could not create " << path << std::endl;
+            return false;
+        }
+        filePath = path;
+        span = chunkSpan;
+        offset = 0;
+        samples = 0;
+        failed = false;
+        pending.clear();
+        rollups.clear();
+        index.clear();
+
+        ArchiveHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+        header.version = ArchiveVersion;
+        header.headerSize = sizeof(ArchiveHeader);
+        header.chunkSpan = span;
+        header.createdAt = nowNanoseconds();
+        header.rollupLevels = static_cast<std::uint32_t>(rollupWidths.size());
+        for (std::size_t i = 0; i < rollupWidths.size(); ++i) {
+            header.rollupWidths[i] = rollupWidths[i];
+        }
+        return write(&header, sizeof(header));
+    }
+
+    bool ArchiveWriter::setRollupLevels(const std::vector<std::int64_t>& widths) {
+        if (widths.size() > MaxRollupLevels) {
+            std::cerr << "ERROR::ARCHIVEWRITER::At most " << MaxRollupLevels << " rollup levels" << std::endl;
+            return false;
+        }
+        for (std::size_t i = 0; i < widths.size(); ++i) {
+            if (widths[i] <= 0 || (i > 0 && widths[i] <= widths[i - 1])) {
+                std::cerr << "ERROR::ARCHIVEWRITER::Rollup widths must be positive and ascending" << std::endl;
+                return false;
+            }
+        }
+        rollupWidths = widths;
+        return true;
+    }
+
+    bool ArchiveWriter::close() {
+        if (!file.is_open()) {
+            return true;
+        }
+        for (ChannelId channel = 0; channel < pending.size(); ++channel) {
+            flushChannel(channel);
+            for (std::uint32_t level = 0; level < rollupWidths.size(); ++level) {
+                RollupLevel& rollup = rollups[channel].levels[level];
+                if (rollup.open.count > 0) {
+                    rollup.closed.push_back(rollup.open);
+                    rollup.open.count = 0;
+                }
+                flushRollups(channel, level);
+            }
+        }
+
+        ArchiveFooter footer;
+        std::memset(&footer, 0, sizeof(footer));
+        footer.indexOffset = offset;
+        footer.entryCount = index.size();
+        footer.indexCrc = crc32(index.data(), index.size() * sizeof(ChunkIndexEntry));
+        std::memcpy(footer.magic, ArchiveMagic, sizeof(ArchiveMagic));
+        write(index.data(), index.size() * sizeof(ChunkIndexEntry));
+        write(&footer, sizeof(footer));
+
+        file.close();
+        pending.clear();
+        rollups.clear();
+        if (failed) {
+            std::cerr << "ERROR::ARCHIVEWRITER::Write failed, " << filePath << " is incomplete" << std::endl;
+        }
+        return !failed;
+    }
+
+    std::int64_t ArchiveWriter::floorTo(std::int64_t timestamp, std::int64_t width) {
+        std::int64_t start = timestamp / width;
+        if (timestamp < 0 && start * width != timestamp) {
+            --start; // floor for negative timestamps
+        }
+        return start * width;
+    }
+
+    void ArchiveWriter::append(SampleSpan batch) {
+        if (!file.is_open()) {
+            return;
+        }
+        for (const Sample& sample : batch) {
+            if (sample.channel >= pending.size()) {
+                pending.resize(static_cast<std::size_t>(sample.channel) + 1, PendingChunk{ 0, {}, {}, true });
+                rollups.resize(pending.size());
+            }
+            PendingChunk& chunk = pending[sample.channel];
+            const std::int64_t start = floorTo(sample.timestamp, span);
+            if (!chunk.timestamps.empty() && (start != chunk.spanStart || chunk.timestamps.size() >= MaxChunkSamples)) {
+                flushChannel(sample.channel);
+            }
+            if (chunk.timestamps.empty()) {
+                chunk.spanStart = start;
+                chunk.allInt = true;
+            }
+            chunk.timestamps.push_back(sample.timestamp);
+            chunk.values.push_back(sample.asDouble());
+            chunk.allInt = chunk.allInt && sample.type == SampleType::Int;
+            addToRollups(sample.channel, sample.timestamp, chunk.values.back());
+            ++samples;
+        }
+    }
+
+    void ArchiveWriter::onSamples(SampleSpan batch) {
+        append(batch);
+    }
+
+    bool ArchiveWriter::importRecording(const RecordingReader& reader) {
+        if (!file.is_open()) {
+            std::cerr << "ERROR::ARCHIVEWRITER::Archive is not open" << std::endl;
+            return false;
+        }
+        std::vector<Sample> scratch;
+        for (std::size_t i = 0; i < reader.blockCount(); ++i) {
+            append(reader.blockSamples(i, scratch));
+        }
+        return !failed;
+    }
+
+    void ArchiveWriter::addToRollups(ChannelId channel, std::int64_t timestamp, double value) {
+        for (std::uint32_t level = 0; level < rollupWidths.size(); ++level) {
+            RollupLevel& rollup = rollups[channel].levels[level];
+            const std::int64_t start = floorTo(timestamp, rollupWidths[level]);
+            if (rollup.open.count > 0 && rollup.open.start != start) {
+                // Late samples open a second bucket for the same interval; readers merge them
+                rollup.closed.push_back(rollup.open);
+                rollup.open.count = 0;
+                if (rollup.closed.size() >= MaxRollupBuckets) {
+                    flushRollups(channel, level);
+                }
+            }
+            if (rollup.open.count == 0) {
+                rollup.open = RollupBucket{ start, 0, 0, value, value, 0.0 };
+            }
+            rollup.open.count++;
+            rollup.open.min = std::min(rollup.open.min, value);
+            rollup.open.max = std::max(rollup.open.max, value);
+            rollup.open.sum += value;
+        }
+    }
+
+    void ArchiveWriter::flushRollups(ChannelId channel, std::uint32_t level) {
+        std::vector<RollupBucket>& buckets = rollups[channel].levels[level].closed;
+        if (buckets.empty()) {
+            return;
+        }
+        std::stable_sort(buckets.begin(), buckets.end(),
+            [](const RollupBucket& a, const RollupBucket& b) { return a.start < b.start; });
+
+        ChunkIndexEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.channel = channel;
+        entry.type = static_cast<std::uint8_t>(SampleType::Double);
+        entry.level = static_cast<std::uint8_t>(level + 1);
+        entry.count = static_cast<std::uint32_t>(buckets.size());
+        entry.offset = offset;
+        entry.firstTimestamp = buckets.front().start;
+        entry.lastTimestamp = buckets.back().start + rollupWidths[level] - 1;
+        entry.minValue = buckets.front().min;
+        entry.maxValue = buckets.front().max;
+        for (const RollupBucket& bucket : buckets) {
+            entry.minValue = std::min(entry.minValue, bucket.min);
+            entry.maxValue = std::max(entry.maxValue, bucket.max);
+            entry.sum += bucket.sum;
+        }
+        entry.crc = crc32(buckets.data(), buckets.size() * sizeof(RollupBucket));
+
+        write(buckets.data(), buckets.size() * sizeof(RollupBucket));
+        index.push_back(entry);
+        buckets.clear();
+    }
+
+    void ArchiveWriter::flushChannel(ChannelId channel) {
+        PendingChunk& chunk = pending[channel];
+        if (chunk.timestamps.empty()) {
+            return;
+        }
+        const std::size_t count = chunk.timestamps.size();
+
+        ChunkIndexEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.channel = channel;
+        entry.type = static_cast<std::uint8_t>(chunk.allInt ? SampleType::Int : SampleType::Double);
+        entry.count = static_cast<std::uint32_t>(count);
+        entry.offset = offset;
+        entry.firstTimestamp = *std::min_element(chunk.timestamps.begin(), chunk.timestamps.end());
+        entry.lastTimestamp = *std::max_element(chunk.timestamps.begin(), chunk.timestamps.end());
+        entry.minValue = chunk.values[0];
+        entry.maxValue = chunk.values[0];
+        entry.sum = 0.0;
+        for (double value : chunk.values) {
+            entry.minValue = std::min(entry.minValue, value);
+            entry.maxValue = std::max(entry.maxValue, value);
+            entry.sum += value;
+        }
+        entry.crc = crc32(chunk.timestamps.data(), count * sizeof(std::int64_t));
+        entry.crc = crc32(chunk.values.data(), count * sizeof(double), entry.crc);
+
+        write(chunk.timestamps.data(), count * sizeof(std::int64_t));
+        write(chunk.values.data(), count * sizeof(double));
+        index.push_back(entry);
+
+        chunk.timestamps.clear();
+        chunk.values.clear();
+    }
+
+    bool ArchiveWriter::write(const void* data, std::size_t size) {
+        if (size == 0) {
+            return !failed;
+        }
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file) {
+            failed = true;
+            return false;
+        }
+        offset += size;
+        return true;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,81 @@
+#ifndef SKYLINE_ARCHIVEWRITER_H
+#define SKYLINE_ARCHIVEWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ArchiveFormat.h"
+#include "Observer.h"
+
+namespace SkyLink {
+
+    class RecordingReader;
+
+    // Writes a columnar mission archive. Samples are buffered per channel
+    // until their time span closes, then written as one chunk; close()
+    // flushes the rest and appends the index and footer. Alongside the raw
+    // chunks it keeps min/max/sum/count rollups at a few bucket widths.
+    class ArchiveWriter : public Observer {
+    public:
+        static const std::int64_t DefaultChunkSpan = 10ll * 1000 * 1000 * 1000; // 10 s
+        static const std::size_t MaxChunkSamples = 1u << 16;
+        static const std::size_t MaxRollupBuckets = 4096;
+
+        ArchiveWriter();
+        ~ArchiveWriter();
+
+        bool open(const std::string& path, std::int64_t chunkSpan = DefaultChunkSpan);
+        // Bucket widths in ns, finest first, at most MaxRollupLevels; call before open().
+        // Defaults to 1 s, 10 s and 1 min; an empty list disables rollups.
+        bool setRollupLevels(const std::vector<std::int64_t>& widths);
+        bool close();
+        bool isOpen() const { return file.is_open(); }
+
+        void append(SampleSpan samples);
+        void onSamples(SampleSpan samples) override;
+        // Post-flight conversion of a flight recorder recording
+        bool importRecording(const RecordingReader& reader);
+
+        std::uint64_t samplesWritten() const { return samples; }
+        std::size_t chunksWritten() const { return index.size(); }
+
+    private:
+        struct PendingChunk {
+            std::int64_t spanStart;
+            std::vector<std::int64_t> timestamps;
+            std::vector<double> values;
+            bool allInt;
+        };
+
+        struct RollupLevel {
+            RollupBucket open;
+            std::vector<RollupBucket> closed;
+        };
+
+        struct ChannelRollups {
+            RollupLevel levels[MaxRollupLevels];
+        };
+
+        static std::int64_t floorTo(std::int64_t timestamp, std::int64_t width);
+        void addToRollups(ChannelId channel, std::int64_t timestamp, double value);
+        void flushChannel(ChannelId channel);
+        void flushRollups(ChannelId channel, std::uint32_t level);
+        bool write(const void* data, std::size_t size);
+
+        std::ofstream file;
+        std::string filePath;
+        std::int64_t span;
+        std::uint64_t offset;
+        std::uint64_t samples;
+        bool failed;
+        std::vector<PendingChunk> pending; // indexed by channel
+        std::vector<std::int64_t> rollupWidths;
+        std::vector<ChannelRollups> rollups; // indexed by channel
+        std::vector<ChunkIndexEntry> index;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_ARCHIVEWRITER_H
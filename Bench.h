@@ -0,0 +1,47 @@
+#ifndef SKYLINE_BENCH_H
+#define SKYLINE_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SkyLink {
+
+    // SkyLinkBench cases. Each prints its figures and returns false when a check fails.
+    bool benchCellLabel();
+    bool benchUdpLoopback();
+    bool benchRecording();
+    bool benchMavlinkParser();
+    bool benchCcsds();
+    bool benchCalibration();
+    bool benchAlarmDisplay();
+    bool benchSequenceTracking();
+    bool benchTelemetryBus();
+    bool benchGorilla();
+    bool benchArchive();
+    bool benchArchiveQuery();
+    bool benchTimestampMerger();
+    bool benchReplay();
+    bool benchRollingStats();
+    bool benchQueuedObserver();
+#ifdef __linux__
+    bool benchSerialPty();
+#endif
+
+    // Heap allocations made by the process so far; SkyLinkBench replaces operator new
+    std::uint64_t allocationCount();
+
+    // MAVLink v1 ATTITUDE (30) frame from system 1, component 1
+    std::vector<std::uint8_t> attitudeFrame(std::uint8_t sequence, std::uint32_t timeBootMs, float roll);
+
+    // Text handed to the stand-in Renderer (BenchRenderer.cpp) so far, folded into a checksum
+    std::size_t renderedChecksum();
+
+    inline double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace SkyLine
+
+#endif // SKYLINE_BENCH_H
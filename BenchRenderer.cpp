@@ -0,0 +1,33 @@
+// Stand-in for Renderer.cpp in SkyLinkBench: the same class without a GL
+// context, FreeType or shaders. Drawing only folds the text into a checksum,
+// so cases can run GridCell::draw() up to the point where GL would take over.
+#include "Bench.h"
+#include "Renderer.h"
+
+namespace SkyLink {
+
+    namespace {
+        std::size_t checksum = 0;
+    }
+
+    Renderer::Renderer()
+        : textShaderProgram(0), triangleShaderProgram(0), triangleVAO(0), triangleVBO(0) {}
+
+    Renderer::~Renderer() {}
+
+    void Renderer::clear() {}
+
+    void Renderer::renderText(std::string_view text, GLfloat, GLfloat, GLfloat, glm::vec3) {
+        checksum += text.size();
+        for (char c : text) {
+            checksum += static_cast<unsigned char>(c);
+        }
+    }
+
+    void Renderer::drawTriangle(float, float, float, glm::vec3) {}
+
+    std::size_t renderedChecksum() {
+        return checksum;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,204 @@
+// Telemetry bus through a real segment: a publisher pushes numbered samples,
+// flat out and then yielding after each batch, while a reader thread follows
+// with peek()/release(). Every sample the reader accepts must be intact and
+// in order, and together with the reader's lost count must add up to what was
+// published. A reader that is lapped on purpose must count exactly the
+// samples the ring no longer holds. A second publisher must not take the
+// name from a live one, a bus left behind by a dead publisher is replaced,
+// and closing must never remove a name that now belongs to someone else.
+#include "Bench.h"
+#include "TelemetryBus.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const BusName = "/skylinkbench-telemetry";
+        const ChannelId Channels = 64;
+        const std::size_t RingSamples = 1 << 16;
+        const std::size_t BatchSamples = 256;
+        const std::uint64_t PublishedSamples = 1ull << 23;
+
+        // Sample number n: channel n % Channels, timestamp and value n
+        void fillBatch(std::vector<Sample>& batch, std::uint64_t first) {
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                const std::uint64_t n = first + i;
+                batch[i] = Sample::fromInt(static_cast<ChannelId>(n % Channels), static_cast<std::int64_t>(n),
+                    static_cast<std::int64_t>(n));
+            }
+        }
+
+        struct ReaderResult {
+            std::uint64_t accepted = 0;
+            std::uint64_t lost = 0;
+            std::uint64_t broken = 0; // out of order or torn, in a run release() vouched for
+            std::uint64_t lapped = 0; // runs release() refused
+        };
+
+        void follow(TelemetryBusReader& reader, const std::atomic<bool>& done, ReaderResult& result) {
+            std::int64_t next = 0;
+            bool finishing = false;
+            for (;;) {
+                const SampleSpan run = reader.peek();
+                if (run.empty()) {
+                    if (finishing) {
+                        break;
+                    }
+                    finishing = done.load(std::memory_order_acquire); // one more pass once the publisher is done
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::int64_t expected = next;
+                std::uint64_t broken = 0;
+                for (const Sample& sample : run) {
+                    if (sample.intValue < expected || sample.timestamp != sample.intValue ||
+                        sample.channel != static_cast<ChannelId>(sample.intValue % Channels)) {
+                        ++broken;
+                    }
+                    expected = sample.intValue + 1;
+                }
+                if (reader.release(run.size())) {
+                    result.accepted += run.size();
+                    result.broken += broken;
+                    next = expected;
+                }
+                else {
+                    ++result.lapped;
+                }
+            }
+            result.lost = reader.lostSamples();
+        }
+
+        // Publish three rings' worth before reading: two of them are gone
+        bool lappedReaderCounts() {
+            TelemetryBusPublisher publisher;
+            TelemetryBusReader reader;
+            if (!publisher.open(BusName, Channels, RingSamples) || !reader.open(BusName)) {
+                return false;
+            }
+            std::vector<Sample> batch(BatchSamples);
+            const std::uint64_t total = 3 * RingSamples;
+            for (std::uint64_t first = 0; first < total; first += BatchSamples) {
+                fillBatch(batch, first);
+                publisher.onSamples(SampleSpan(batch.data(), batch.size()));
+            }
+            std::vector<Sample> out(RingSamples);
+            std::uint64_t read = 0;
+            bool inOrder = true;
+            for (std::size_t count; (count = reader.read(out.data(), out.size())) > 0; ) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    inOrder = inOrder && out[i].intValue == static_cast<std::int64_t>(total - RingSamples + read + i);
+                }
+                read += count;
+            }
+            Sample latest;
+            const bool latestKept = reader.latest(Channels - 1, latest) &&
+                latest.intValue == static_cast<std::int64_t>(total - 1);
+            return inOrder && latestKept && read == RingSamples && reader.lostSamples() == total - RingSamples;
+        }
+
+        // Reader thread behind a publisher that either never stops or yields after every batch,
+        // the way the drain loop hands the bus one batch per frame
+        bool followPublisher(bool yieldPerBatch, const char* name) {
+            TelemetryBusPublisher publisher;
+            TelemetryBusReader reader;
+            if (!publisher.open(BusName, Channels, RingSamples) || !reader.open(BusName)) {
+                return false;
+            }
+
+            std::atomic<bool> done(false);
+            ReaderResult result;
+            std::thread follower([&reader, &done, &result]() {
+                follow(reader, done, result);
+            });
+
+            std::vector<Sample> batch(BatchSamples);
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t first = 0; first < PublishedSamples; first += BatchSamples) {
+                fillBatch(batch, first);
+                publisher.onSamples(SampleSpan(batch.data(), batch.size()));
+                if (yieldPerBatch) {
+                    std::this_thread::yield();
+                }
+            }
+            const double publishSeconds = secondsSince(start);
+            done.store(true, std::memory_order_release);
+            follower.join();
+            const double readSeconds = secondsSince(start);
+            const bool accounted = publisher.published() == PublishedSamples && result.accepted + result.lost == PublishedSamples;
+
+            std::printf("%-15s published %.1f M samples/s, read %.1f M samples/s, %llu lost, %llu lapped runs; "
+                "read + lost = published: %s, intact and in order: %s\n",
+                name, PublishedSamples / publishSeconds / 1e6, result.accepted / readSeconds / 1e6,
+                static_cast<unsigned long long>(result.lost), static_cast<unsigned long long>(result.lapped),
+                accounted ? "yes" : "no", result.broken == 0 ? "yes" : "no");
+            return accounted && result.broken == 0;
+        }
+
+        // One sample on channel 0 through the bus under BusName, as a reader attached now sees it
+        bool carries(TelemetryBusPublisher& publisher, std::int64_t value) {
+            TelemetryBusReader reader;
+            if (!reader.open(BusName)) {
+                return false;
+            }
+            const Sample sample = Sample::fromInt(0, value, value);
+            publisher.onSamples(SampleSpan(&sample, 1));
+            Sample out;
+            return reader.read(&out, 1) == 1 && out.intValue == value;
+        }
+
+        bool nameOwnership() {
+            TelemetryBusPublisher first;
+            TelemetryBusPublisher second;
+            if (!first.open(BusName, Channels, RingSamples)) {
+                return false;
+            }
+            const bool liveKept = !second.open(BusName, Channels, RingSamples) && carries(first, 1);
+            first.close();
+            const bool freedOnClose = second.open(BusName, Channels, RingSamples) && carries(second, 2);
+            second.close();
+
+            bool staleReplaced = true;
+            bool successorKept = true;
+#ifndef _WIN32
+            // POSIX names outlive their process. Leave one behind the way a publisher that died
+            // would: state Live, a process id nobody has
+            SharedMemory leftover;
+            if (!leftover.create(BusName, sizeof(BusHeader))) {
+                return false;
+            }
+            BusHeader* header = new (leftover.data()) BusHeader();
+            std::memcpy(header->magic, BusMagic, sizeof(BusMagic));
+            header->publisherProcess = 0x7FFFFFF0u;
+            header->state.store(static_cast<std::uint32_t>(BusState::Live), std::memory_order_release);
+            staleReplaced = first.open(BusName, Channels, RingSamples) && carries(first, 3);
+            // leftover still owns its old segment, but the name is first's now and must stay
+            leftover.close();
+            successorKept = carries(first, 4);
+            first.close();
+#endif
+
+            std::printf("second publisher refused: %s, name free after close: %s, dead publisher's bus replaced: %s, "
+                "successor's name kept: %s\n", liveKept ? "yes" : "no", freedOnClose ? "yes" : "no",
+                staleReplaced ? "yes" : "no", successorKept ? "yes" : "no");
+            return liveKept && freedOnClose && staleReplaced && successorKept;
+        }
+
+    } // namespace
+
+    bool benchTelemetryBus() {
+        const bool flatOut = followPublisher(false, "flat out");
+        const bool paced = followPublisher(true, "yield per batch");
+        const bool lapped = lappedReaderCounts();
+        std::printf("lapped reader counts: %s\n", lapped ? "yes" : "no");
+        const bool owned = nameOwnership();
+        return flatOut && paced && lapped && owned;
+    }
+
+} // namespace SkyLine
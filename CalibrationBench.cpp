@@ -0,0 +1,228 @@
+// Calibration stage against the path it replaces: one virtual call per
+// value into a per-channel calibrator. Two workloads, 2000 channels of mixed
+// polynomials, tables and enum maps, and 2000 channels of the same cubic.
+// Both paths must agree bit for bit, also after a third of the mixed
+// channels are recalibrated and some cleared, and enum channels must pass
+// unmapped int64 raw values through exactly. Times include copying the batch.
+#include "Bench.h"
+#include "CalibrationStage.h"
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const ChannelId ChannelCount = 2000;
+        const std::size_t BatchSamples = 8192;
+        const int Passes = 500;
+
+        class Calibrator {
+        public:
+            virtual void apply(Sample& sample) const = 0;
+            virtual ~Calibrator() = default;
+        };
+
+        class PolynomialCalibrator : public Calibrator {
+        public:
+            explicit PolynomialCalibrator(const std::vector<double>& coefficients) : coefficients(coefficients) {}
+
+            void apply(Sample& sample) const override {
+                const double x = sample.asDouble();
+                double acc = coefficients.back();
+                for (std::size_t k = coefficients.size() - 1; k > 0; --k) {
+                    acc = acc * x + coefficients[k - 1];
+                }
+                sample.type = SampleType::Double;
+                sample.doubleValue = acc;
+            }
+
+        private:
+            std::vector<double> coefficients;
+        };
+
+        class PiecewiseCalibrator : public Calibrator {
+        public:
+            explicit PiecewiseCalibrator(const std::vector<CalibrationStage::Breakpoint>& table) : table(table) {}
+
+            void apply(Sample& sample) const override {
+                const double x = sample.asDouble();
+                double value = x <= table.front().raw ? table.front().value : table.back().value;
+                for (std::size_t k = 1; k < table.size(); ++k) {
+                    if (x >= table[k - 1].raw && x < table[k].raw) {
+                        const double t = (x - table[k - 1].raw) / (table[k].raw - table[k - 1].raw);
+                        value = table[k - 1].value + t * (table[k].value - table[k - 1].value);
+                        break;
+                    }
+                }
+                sample.type = SampleType::Double;
+                sample.doubleValue = value;
+            }
+
+        private:
+            std::vector<CalibrationStage::Breakpoint> table;
+        };
+
+        class EnumCalibrator : public Calibrator {
+        public:
+            explicit EnumCalibrator(const std::vector<std::pair<std::int64_t, std::int64_t>>& map) : map(map) {}
+
+            void apply(Sample& sample) const override {
+                for (const auto& entry : map) {
+                    if (entry.first == sample.intValue) {
+                        sample.intValue = entry.second;
+                        return;
+                    }
+                }
+            }
+
+        private:
+            std::vector<std::pair<std::int64_t, std::int64_t>> map;
+        };
+
+        struct Reference {
+            std::vector<std::unique_ptr<Calibrator>> calibrators; // by channel
+
+            void process(Sample* samples, std::size_t count) const {
+                for (std::size_t i = 0; i < count; ++i) {
+                    calibrators[samples[i].channel]->apply(samples[i]);
+                }
+            }
+        };
+
+        enum class Workload { Mixed, UniformCubic };
+
+        // Calibration kind 0..7 of a mixed channel, scattered so channel order says nothing about it
+        unsigned mixedKind(ChannelId channel) {
+            return (channel * 2654435761u >> 16) % 8;
+        }
+
+        class Passthrough : public Calibrator {
+        public:
+            void apply(Sample&) const override {}
+        };
+
+    void configureChannel(ChannelId channel, unsigned kind, CalibrationStage& stage, Reference& reference) {
+            if (kind < 4) {
+                const std::vector<double> cubic = { 0.5, 1.0 + 1e-3 * (channel % 7), -2e-6, 3e-10 };
+                stage.setPolynomial(channel, cubic);
+                reference.calibrators[channel].reset(new PolynomialCalibrator(cubic));
+            }
+            else if (kind < 6) {
+                std::vector<double> poly(kind == 4 ? 2 : 6, 1e-4);
+                poly[0] = -1.0;
+                stage.setPolynomial(channel, poly);
+                reference.calibrators[channel].reset(new PolynomialCalibrator(poly));
+            }
+            else if (kind == 6) {
+                const std::vector<CalibrationStage::Breakpoint> table = {
+                    { 0.0, -40.0 }, { 1000.0, 0.0 }, { 2500.0, 25.0 }, { 4095.0, 125.0 } };
+                stage.setPiecewiseLinear(channel, table);
+                reference.calibrators[channel].reset(new PiecewiseCalibrator(table));
+            }
+            else {
+                const std::vector<std::pair<std::int64_t, std::int64_t>> map = { { 0, 10 }, { 1, 11 }, { 2, 12 }, { 7, 17 } };
+                stage.setEnumMap(channel, map);
+                reference.calibrators[channel].reset(new EnumCalibrator(map));
+                }
+        }
+
+        void configure(Workload workload, CalibrationStage& stage, Reference& reference) {
+            reference.calibrators.resize(ChannelCount);
+            for (ChannelId channel = 0; channel < ChannelCount; ++channel) {
+                configureChannel(channel, workload == Workload::UniformCubic ? 0 : mixedKind(channel), stage, reference);
+            }
+            if (workload == Workload::UniformCubic) {
+                return;
+            }
+            // Replace and clear calibrations from the middle of the stage's tables
+            for (ChannelId channel = 0; channel < ChannelCount; channel += 3) {
+                configureChannel(channel, (mixedKind(channel) + 3) % 8, stage, reference);
+            }
+            for (ChannelId channel = 0; channel < ChannelCount; channel += 11) {
+                stage.clearCalibration(channel);
+                reference.calibrators[channel].reset(new Passthrough());
+            }
+        }
+
+        std::vector<Sample> makeBatch(Workload workload) {
+            // Enum raw values include int64 counts a double cannot hold
+            const std::int64_t wideRaw = std::numeric_limits<std::int64_t>::max() - 6;
+            std::vector<Sample> batch(BatchSamples);
+            for (std::size_t i = 0; i < BatchSamples; ++i) {
+                const ChannelId channel = static_cast<ChannelId>((i * 7919) % ChannelCount);
+                const std::int64_t timestamp = static_cast<std::int64_t>(i);
+                if (workload == Workload::Mixed && mixedKind(channel) == 7) {
+                    batch[i] = Sample::fromInt(channel, timestamp, i % 3 == 0 ? wideRaw - static_cast<std::int64_t>(i) : static_cast<std::int64_t>(i % 8));
+                }
+                else {
+                    batch[i] = Sample::fromInt(channel, timestamp, static_cast<std::int64_t>((i * 2654435761u) % 4096));
+                }
+            }
+            return batch;
+        }
+
+        bool sameSamples(const std::vector<Sample>& a, const std::vector<Sample>& b) {
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (a[i].type != b[i].type || a[i].intValue != b[i].intValue) {
+                    std::printf("sample %zu on channel %u differs\n", i, a[i].channel);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // ns per sample, best of three rounds so a noisy host does not pick the winner
+        template <typename Process>
+        double timePerSample(const std::vector<Sample>& input, std::vector<Sample>& output, Process&& process) {
+            double best = 0.0;
+            for (int round = 0; round < 3; ++round) {
+                const auto start = std::chrono::steady_clock::now();
+                for (int pass = 0; pass < Passes; ++pass) {
+                    output = input;
+                    process(output.data(), output.size());
+                }
+                const double seconds = secondsSince(start);
+                if (round == 0 || seconds < best) {
+                    best = seconds;
+                }
+            }
+            return best / (static_cast<double>(BatchSamples) * Passes) * 1e9;
+        }
+
+        bool runWorkload(Workload workload, const char* name) {
+            CalibrationStage stage;
+            Reference reference;
+            configure(workload, stage, reference);
+            const std::vector<Sample> input = makeBatch(workload);
+
+            std::vector<Sample> expected(input);
+            std::vector<Sample> staged(input);
+            reference.process(expected.data(), expected.size());
+            stage.process(staged.data(), staged.size());
+            const bool exact = sameSamples(staged, expected);
+
+            std::vector<Sample> work;
+            const double referenceNs = timePerSample(input, work, [&reference](Sample* samples, std::size_t count) {
+                reference.process(samples, count);
+            });
+            const double stageNs = timePerSample(input, work, [&stage](Sample* samples, std::size_t count) {
+                stage.process(samples, count);
+            });
+
+            std::printf("%-13s virtual reference %.2f ns/sample, stage %.2f ns/sample, results match: %s\n",
+                name, referenceNs, stageNs, exact ? "yes" : "no");
+            return exact;
+        }
+
+    } // namespace
+
+    bool benchCalibration() {
+        const bool mixed = runWorkload(Workload::Mixed, "mixed");
+        const bool cubic = runWorkload(Workload::UniformCubic, "uniform cubic");
+        return mixed && cubic;
+    }
+
+} // namespace SkyLine
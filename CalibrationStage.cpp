@@ -0,0 +1,163 @@
+#include "CalibrationStage.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace SkyLink {
+
+    namespace {
+
+        // Horner's rule, coefficients highest power first
+        inline double evaluatePolynomial(const double* terms, std::uint32_t count, double x) {
+            double acc = terms[0];
+            for (std::uint32_t k = 1; k < count; ++k) {
+                acc = acc * x + terms[k];
+            }
+            return acc;
+        }
+
+        inline double evaluatePiecewise(const double* raws, const double* values, std::uint32_t count, double x) {
+            const double* upper = std::upper_bound(raws, raws + count, x);
+            if (upper == raws) {
+                return values[0];
+            }
+            if (upper == raws + count) {
+                return values[count - 1];
+            }
+            const std::size_t hi = static_cast<std::size_t>(upper - raws);
+            const double t = (x - raws[hi - 1]) / (raws[hi] - raws[hi - 1]);
+            return values[hi - 1] + t * (values[hi] - values[hi - 1]);
+        }
+
+        inline std::int64_t mapEnum(const std::int64_t* keys, const std::int64_t* states, std::uint32_t count, std::int64_t key) {
+            const std::int64_t* match = std::lower_bound(keys, keys + count, key);
+            return (match != keys + count && *match == key) ? states[match - keys] : key;
+        }
+
+    } // namespace
+
+    CalibrationStage::Dispatch& CalibrationStage::dispatchFor(ChannelId channel) {
+        if (channel >= dispatch.size()) {
+            dispatch.resize(static_cast<std::size_t>(channel) + 1, Dispatch{ Kind::None, 0, 0 });
+        }
+        return dispatch[channel];
+    }
+
+    void CalibrationStage::release(const Dispatch& old) {
+        switch (old.kind) {
+        case Kind::None:
+            return;
+        case Kind::Polynomial:
+            terms.erase(terms.begin() + old.first, terms.begin() + old.first + old.count);
+            break;
+        case Kind::PiecewiseLinear:
+            raws.erase(raws.begin() + old.first, raws.begin() + old.first + old.count);
+            levels.erase(levels.begin() + old.first, levels.begin() + old.first + old.count);
+            break;
+        case Kind::EnumMap:
+            codes.erase(codes.begin() + old.first, codes.begin() + old.first + old.count);
+            states.erase(states.begin() + old.first, states.begin() + old.first + old.count);
+            break;
+        }
+        for (Dispatch& other : dispatch) {
+            if (other.kind == old.kind && other.first > old.first) {
+                other.first -= old.count;
+            }
+        }
+    }
+
+    bool CalibrationStage::setPolynomial(ChannelId channel, const std::vector<double>& coefficients) {
+        if (coefficients.empty()) {
+            std::cerr << "ERROR::CALIBRATION::Empty polynomial for channel " << channel << std::endl;
+            return false;
+        }
+        clearCalibration(channel);
+
+        const std::uint32_t first = static_cast<std::uint32_t>(terms.size());
+        terms.insert(terms.end(), coefficients.rbegin(), coefficients.rend());
+        dispatchFor(channel) = Dispatch{ Kind::Polynomial, static_cast<std::uint32_t>(coefficients.size()), first };
+        return true;
+    }
+
+    bool CalibrationStage::setPiecewiseLinear(ChannelId channel, std::vector<Breakpoint> table) {
+        if (table.empty()) {
+            std::cerr << "ERROR::CALIBRATION::Empty breakpoint table for channel " << channel << std::endl;
+            return false;
+        }
+        std::sort(table.begin(), table.end(), [](const Breakpoint& a, const Breakpoint& b) { return a.raw < b.raw; });
+        clearCalibration(channel);
+
+        const std::uint32_t first = static_cast<std::uint32_t>(raws.size());
+        for (const Breakpoint& point : table) {
+            raws.push_back(point.raw);
+            levels.push_back(point.value);
+        }
+        dispatchFor(channel) = Dispatch{ Kind::PiecewiseLinear, static_cast<std::uint32_t>(table.size()), first };
+        return true;
+    }
+
+    bool CalibrationStage::setEnumMap(ChannelId channel, std::vector<std::pair<std::int64_t, std::int64_t>> map) {
+        if (map.empty()) {
+            std::cerr << "ERROR::CALIBRATION::Empty enum map for channel " << channel << std::endl;
+            return false;
+        }
+        std::sort(map.begin(), map.end());
+        clearCalibration(channel);
+
+        const std::uint32_t first = static_cast<std::uint32_t>(codes.size());
+        for (const auto& mapping : map) {
+            codes.push_back(mapping.first);
+            states.push_back(mapping.second);
+        }
+        dispatchFor(channel) = Dispatch{ Kind::EnumMap, static_cast<std::uint32_t>(map.size()), first };
+        return true;
+    }
+
+    void CalibrationStage::clearCalibration(ChannelId channel) {
+        if (channel >= dispatch.size()) {
+            return;
+        }
+        const Dispatch old = dispatch[channel];
+        dispatch[channel] = Dispatch{ Kind::None, 0, 0 };
+        release(old);
+    }
+
+    void CalibrationStage::process(Sample* samples, std::size_t count) {
+        const Dispatch* table = dispatch.data();
+        const std::size_t channelCount = dispatch.size();
+        const double* coefficients = terms.data();
+        const double* breakpoints = raws.data();
+        const double* outputs = levels.data();
+        const std::int64_t* keys = codes.data();
+        const std::int64_t* mapped = states.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            Sample& sample = samples[i];
+            if (sample.channel >= channelCount) {
+                continue;
+            }
+            const Dispatch& entry = table[sample.channel];
+            switch (entry.kind) {
+            case Kind::None:
+                break;
+            case Kind::Polynomial:
+                sample.doubleValue = evaluatePolynomial(coefficients + entry.first, entry.count, sample.asDouble());
+                sample.type = SampleType::Double;
+                break;
+            case Kind::PiecewiseLinear:
+                sample.doubleValue = evaluatePiecewise(breakpoints + entry.first, outputs + entry.first, entry.count, sample.asDouble());
+                sample.type = SampleType::Double;
+                break;
+            case Kind::EnumMap:
+                if (sample.type == SampleType::Int) {
+                    sample.intValue = mapEnum(keys + entry.first, mapped + entry.first, entry.count, sample.intValue);
+                }
+                else if (std::isfinite(sample.doubleValue)) {
+                    sample.intValue = mapEnum(keys + entry.first, mapped + entry.first, entry.count, std::llround(sample.doubleValue));
+                    sample.type = SampleType::Int;
+                }
+                break;
+            }
+        }
+    }
+
+} // namespace SkyLine
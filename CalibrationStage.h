@@ -0,0 +1,60 @@
+#ifndef SKYLINE_CALIBRATIONSTAGE_H
+#define SKYLINE_CALIBRATIONSTAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Sample.h"
+#include "TelemetryStage.h"
+
+namespace SkyLink {
+
+    // Converts raw counts to engineering units. Every sample is calibrated in
+    // place through one per-channel dispatch entry that locates its
+    // coefficients or table, so there is no virtual call per value and
+    // no extra pass over the batch. Channels without a calibration pass
+    // through untouched; enum keys are read as int64 and never round through
+    // double.
+    class CalibrationStage : public TelemetryStage {
+    public:
+        struct Breakpoint {
+            double raw;
+            double value;
+        };
+
+        // coefficients[k] multiplies raw^k
+        bool setPolynomial(ChannelId channel, const std::vector<double>& coefficients);
+        // Linear interpolation between breakpoints, clamped at both ends
+        bool setPiecewiseLinear(ChannelId channel, std::vector<Breakpoint> table);
+        // Raw integer -> state code; unmapped raw values pass through unchanged
+        bool setEnumMap(ChannelId channel, std::vector<std::pair<std::int64_t, std::int64_t>> map);
+        void clearCalibration(ChannelId channel);
+
+        void process(Sample* samples, std::size_t count) override;
+
+    private:
+        enum class Kind : std::uint8_t { None, Polynomial, PiecewiseLinear, EnumMap };
+
+        // What process() needs for one channel. Coefficients and tables of
+        // every channel of a kind are stored back to back in that kind's pool.
+        struct Dispatch {
+            Kind kind;
+            std::uint32_t count; // coefficients or table entries
+            std::uint32_t first; // into the pool for kind
+        };
+
+        Dispatch& dispatchFor(ChannelId channel);
+        void release(const Dispatch& old); // erases old's pool range and closes the gap
+
+        std::vector<Dispatch> dispatch; // indexed by channel
+        std::vector<double> terms;      // polynomial coefficients, highest power first
+        std::vector<double> raws;       // piecewise breakpoints
+        std::vector<double> levels;
+        std::vector<std::int64_t> codes; // enum keys
+        std::vector<std::int64_t> states;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_CALIBRATIONSTAGE_H
@@ -0,0 +1,150 @@
+// CCSDS integer round trip: 64-bit fields in both byte orders must come out
+// of the decoder bit-exact, a uint64 above INT64_MAX saturates and is
+// counted, a definition with an out-of-range width is rejected without
+// touching the loaded one, and reloading a definition replaces it. Two
+// packets for the same APID in one buffer must both reach the provider, in
+// packet order.
+#include "Bench.h"
+#include "CcsdsDecoder.h"
+#include "DataProvider.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const DefinitionPath = "skylinkbench-ccsds.def";
+        const char* const BadDefinitionPath = "skylinkbench-ccsds-bad.def";
+        const std::uint16_t Apid = 100;
+        const std::size_t DataBytes = 50;
+
+        const char* const Definition =
+            "# apid channel bitOffset bitWidth type endian\n"
+            "100 0 0 64 uint big\n"
+            "100 1 64 64 uint little\n"
+            "100 2 128 64 int big\n"
+            "100 3 192 64 int little\n"
+            "100 4 256 64 uint big\n"
+            "100 5 320 12 int big\n"
+            "100 6 332 4 uint big\n"
+            "100 7 336 64 float big\n";
+
+        void storeBe(std::uint8_t* p, std::uint64_t value) {
+            for (int i = 7; i >= 0; --i) {
+                p[i] = static_cast<std::uint8_t>(value);
+                value >>= 8;
+            }
+        }
+
+        void storeLe(std::uint8_t* p, std::uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                p[i] = static_cast<std::uint8_t>(value);
+                value >>= 8;
+            }
+        }
+
+        void writeFile(const char* path, const char* text) {
+            std::ofstream file(path, std::ios::trunc);
+            file << text;
+        }
+
+        class Collector : public Observer {
+        public:
+            std::vector<Sample> samples;
+
+            void onSamples(SampleSpan batch) override {
+                samples.insert(samples.end(), batch.begin(), batch.end());
+            }
+        };
+
+    } // namespace
+
+    bool benchCcsds() {
+        const std::uint64_t allOnes = ~std::uint64_t(0);
+        const std::uint64_t beyondDouble = (std::uint64_t(1) << 53) + 1;
+        const std::int64_t int64Min = std::numeric_limits<std::int64_t>::min();
+        const std::int64_t negativeBeyondDouble = -(std::int64_t(1) << 53) - 1;
+        const std::int64_t int64Max = std::numeric_limits<std::int64_t>::max();
+        const double real = 1.0 / 3.0;
+
+        std::uint8_t packet[CcsdsDecoder::PrimaryHeaderBytes + DataBytes] = {};
+        packet[0] = static_cast<std::uint8_t>(Apid >> 8);
+        packet[1] = static_cast<std::uint8_t>(Apid);
+        packet[4] = static_cast<std::uint8_t>((DataBytes - 1) >> 8);
+        packet[5] = static_cast<std::uint8_t>(DataBytes - 1);
+        std::uint8_t* data = packet + CcsdsDecoder::PrimaryHeaderBytes;
+        storeBe(data, allOnes);
+        storeLe(data + 8, beyondDouble);
+        storeBe(data + 16, static_cast<std::uint64_t>(int64Min));
+        storeLe(data + 24, static_cast<std::uint64_t>(negativeBeyondDouble));
+        storeBe(data + 32, static_cast<std::uint64_t>(int64Max));
+        data[40] = 0xFF; // 12-bit -1, then 4-bit 0xF
+        data[41] = 0xFF;
+        std::uint64_t realBits;
+        std::memcpy(&realBits, &real, sizeof(realBits));
+        storeBe(data + 42, realBits);
+
+        writeFile(DefinitionPath, Definition);
+        writeFile(BadDefinitionPath, "100 0 0 264 uint big\n");
+
+        CcsdsDecoder decoder;
+        const bool loaded = decoder.loadDefinition(DefinitionPath);
+        const bool badRejected = !decoder.loadDefinition(BadDefinitionPath) && decoder.fieldCount() == 8;
+        const bool reloaded = decoder.loadDefinition(DefinitionPath) && decoder.fieldCount() == 8;
+        std::remove(DefinitionPath);
+        std::remove(BadDefinitionPath);
+
+        DataProvider provider(64);
+        Collector collector;
+        provider.attach(&collector);
+        const std::size_t packets = decoder.decode(packet, sizeof(packet), 42, provider);
+        provider.drain();
+
+        const std::int64_t expected[] = {
+            int64Max, // saturated
+            static_cast<std::int64_t>(beyondDouble),
+            int64Min,
+            negativeBeyondDouble,
+            int64Max,
+            -1,
+            15
+        };
+        bool exact = packets == 1 && collector.samples.size() == 8;
+        for (ChannelId channel = 0; channel < 7 && exact; ++channel) {
+            const Sample& sample = collector.samples[channel];
+            if (sample.type != SampleType::Int || sample.intValue != expected[channel] || sample.timestamp != 42) {
+                std::printf("channel %u: %lld, expected %lld\n", channel, static_cast<long long>(sample.intValue),
+                    static_cast<long long>(expected[channel]));
+                exact = false;
+            }
+        }
+        exact = exact && collector.samples[7].type == SampleType::Double && collector.samples[7].doubleValue == real;
+
+        // The same packet twice, the second with 5 in the 4-bit field on channel 6
+        std::vector<std::uint8_t> pair(packet, packet + sizeof(packet));
+        pair.insert(pair.end(), packet, packet + sizeof(packet));
+        pair[sizeof(packet) + CcsdsDecoder::PrimaryHeaderBytes + 41] = 0xF5;
+        collector.samples.clear();
+        const std::size_t pairPackets = decoder.decode(pair.data(), pair.size(), 43, provider);
+        provider.drain();
+        std::vector<std::int64_t> nibbles;
+        for (const Sample& sample : collector.samples) {
+            if (sample.channel == 6) {
+                nibbles.push_back(sample.intValue);
+            }
+        }
+        const bool bothPackets = pairPackets == 2 && collector.samples.size() == 16 &&
+            nibbles == std::vector<std::int64_t>{ 15, 5 };
+
+        std::printf("definition loaded: %s, width 264 rejected: %s, reload replaces: %s\n",
+            loaded ? "yes" : "no", badRejected ? "yes" : "no", reloaded ? "yes" : "no");
+        std::printf("64-bit fields exact: %s, saturated %llu, same-APID packets both posted: %s\n", exact ? "yes" : "no",
+            static_cast<unsigned long long>(decoder.saturatedValues()), bothPackets ? "yes" : "no");
+        return loaded && badRejected && reloaded && exact && bothPackets && decoder.saturatedValues() == 3;
+    }
+
+} // namespace SkyLine
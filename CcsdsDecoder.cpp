@@ -0,0 +1,299 @@
+#include "CcsdsDecoder.h"
+#include "DataProvider.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace SkyLink {
+
+    namespace {
+
+        inline std::uint16_t load16be(const std::uint8_t* p) {
+            return static_cast<std::uint16_t>((p[0] << 8) | p[1]);
+        }
+
+        inline std::uint32_t load32be(const std::uint8_t* p) {
+            return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16) |
+                (static_cast<std::uint32_t>(p[2]) << 8) | p[3];
+        }
+
+        inline std::uint64_t load64be(const std::uint8_t* p) {
+            return (static_cast<std::uint64_t>(load32be(p)) << 32) | load32be(p + 4);
+        }
+
+        template <typename T>
+        inline T loadLe(const std::uint8_t* p) {
+            T value;
+            std::memcpy(&value, p, sizeof(T)); // little-endian hosts only
+            return value;
+        }
+
+        inline std::int64_t signExtend(std::uint64_t value, unsigned bits) {
+            if (bits >= 64) {
+                return static_cast<std::int64_t>(value);
+            }
+            const std::uint64_t sign = std::uint64_t(1) << (bits - 1);
+            return static_cast<std::int64_t>((value ^ sign) - sign);
+        }
+
+    } // namespace
+
+    CcsdsDecoder::CcsdsDecoder()
+        : plans(MaxApid + 1), maxChannel(0), decoded(0), unknownApid(0), tooShort(0), saturated(0) {
+        for (Plan& plan : plans) {
+            plan.first = 0;
+            plan.count = 0;
+            plan.minBytes = 0;
+        }
+    }
+
+    bool CcsdsDecoder::loadDefinition(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "ERROR::CCSDS::Could not open definition " << path << std::endl;
+            return false;
+        }
+
+        std::vector<FieldDefinition> loaded;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            const std::size_t comment = line.find('#');
+            if (comment != std::string::npos) {
+                line.erase(comment);
+            }
+            std::istringstream stream(line);
+            unsigned apid, channel, bitOffset, bitWidth;
+            std::string kind, endian;
+            if (!(stream >> apid)) {
+                continue; // blank line
+            }
+            if (!(stream >> channel >> bitOffset >> bitWidth >> kind >> endian)) {
+                std::cerr << "ERROR::CCSDS::" << path << ":" << lineNumber << ": expected 6 columns" << std::endl;
+                return false;
+            }
+            // Range-check before narrowing into the definition
+            if (apid > MaxApid || bitWidth == 0 || bitWidth > 64 || (endian != "big" && endian != "little")) {
+                std::cerr << "ERROR::CCSDS::" << path << ":" << lineNumber << ": invalid field" << std::endl;
+                return false;
+            }
+            FieldDefinition field;
+            field.apid = static_cast<std::uint16_t>(apid);
+            field.channel = channel;
+            field.bitOffset = bitOffset;
+            field.bitWidth = static_cast<std::uint8_t>(bitWidth);
+            field.littleEndian = endian == "little";
+            field.scale = 1.0;
+            stream >> field.scale;
+            if (kind == "uint") field.kind = FieldKind::Unsigned;
+            else if (kind == "int") field.kind = FieldKind::Signed;
+            else if (kind == "float") field.kind = FieldKind::Float;
+            else {
+                std::cerr << "ERROR::CCSDS::" << path << ":" << lineNumber << ": unknown type " << kind << std::endl;
+                return false;
+            }
+            if (!isValid(field)) {
+                std::cerr << "ERROR::CCSDS::" << path << ":" << lineNumber << ": invalid field" << std::endl;
+                return false;
+            }
+            loaded.push_back(field);
+        }
+        definitions.swap(loaded);
+        compile();
+        return true;
+    }
+
+    bool CcsdsDecoder::addField(const FieldDefinition& field) {
+        if (!isValid(field)) {
+            return false;
+        }
+        definitions.push_back(field);
+        return true;
+    }
+
+    bool CcsdsDecoder::isValid(const FieldDefinition& field) {
+        const bool aligned = field.bitOffset % 8 == 0;
+        if (field.apid > MaxApid || field.bitWidth == 0 || field.bitWidth > 64) {
+            return false;
+        }
+        if (field.kind == FieldKind::Float && (!aligned || (field.bitWidth != 32 && field.bitWidth != 64))) {
+            return false;
+        }
+        if (field.littleEndian && (!aligned || field.bitWidth % 8 != 0)) {
+            return false;
+        }
+        // Bit-field extraction works in one 64-bit window
+        return field.bitOffset % 8 + field.bitWidth <= 64;
+    }
+
+    void CcsdsDecoder::compile() {
+        std::vector<FieldDefinition> sorted(definitions);
+        std::stable_sort(sorted.begin(), sorted.end(), [](const FieldDefinition& a, const FieldDefinition& b) {
+            return a.apid != b.apid ? a.apid < b.apid : a.bitOffset < b.bitOffset;
+            });
+
+        steps.clear();
+        for (Plan& plan : plans) {
+            plan.first = 0;
+            plan.count = 0;
+            plan.minBytes = 0;
+        }
+        maxChannel = 0;
+
+        for (const FieldDefinition& field : sorted) {
+            Plan& plan = plans[field.apid];
+            if (plan.count == 0) {
+                plan.first = static_cast<std::uint32_t>(steps.size());
+            }
+
+            PlanStep step;
+            step.isSigned = field.kind == FieldKind::Signed;
+            step.bitWidth = field.bitWidth;
+            step.bitShift = 0;
+            step.byteCount = static_cast<std::uint8_t>((field.bitOffset % 8 + field.bitWidth + 7) / 8);
+            step.byteOffset = field.bitOffset / 8;
+            step.channel = field.channel;
+            step.scale = field.scale;
+
+            const std::uint32_t lastByte = (field.bitOffset + field.bitWidth + 7) / 8;
+            const bool aligned = field.bitOffset % 8 == 0;
+            const bool le = field.littleEndian;
+            if (field.kind == FieldKind::Float) {
+                step.op = field.bitWidth == 32 ? (le ? Op::F32LE : Op::F32BE) : (le ? Op::F64LE : Op::F64BE);
+            }
+            else if (aligned && field.bitWidth == 8) {
+                step.op = Op::U8;
+            }
+            else if (aligned && field.bitWidth == 16) {
+                step.op = le ? Op::U16LE : Op::U16BE;
+            }
+            else if (aligned && field.bitWidth == 32) {
+                step.op = le ? Op::U32LE : Op::U32BE;
+            }
+            else if (aligned && field.bitWidth == 64) {
+                step.op = le ? Op::U64LE : Op::U64BE;
+            }
+            else if (le) {
+                step.op = Op::BytesLE;
+            }
+            else {
+                step.op = Op::BitsBE;
+                step.bitShift = static_cast<std::uint8_t>(step.byteCount * 8 - field.bitOffset % 8 - field.bitWidth);
+            }
+
+            plan.minBytes = std::max(plan.minBytes, lastByte);
+            maxChannel = std::max(maxChannel, field.channel);
+            steps.push_back(step);
+            ++plan.count;
+        }
+        frame.clearUpdated();
+        frame.resize(steps.empty() ? 0 : static_cast<std::size_t>(maxChannel) + 1);
+    }
+
+    std::size_t CcsdsDecoder::decode(const std::uint8_t* data, std::size_t size, std::int64_t timestamp, DataProvider& target) {
+        std::size_t packets = 0;
+        std::size_t offset = 0;
+        while (offset + PrimaryHeaderBytes <= size) {
+            const std::uint8_t* packet = data + offset;
+            const std::uint16_t apid = load16be(packet) & MaxApid;
+            const std::size_t dataFieldBytes = static_cast<std::size_t>(load16be(packet + 4)) + 1;
+            if (offset + PrimaryHeaderBytes + dataFieldBytes > size) {
+                ++tooShort;
+                break;
+            }
+
+            const Plan& plan = plans[apid];
+            if (plan.count == 0) {
+                ++unknownApid;
+            }
+            else if (plan.minBytes > dataFieldBytes) {
+                ++tooShort;
+            }
+            else {
+                // Post before the next packet can overwrite a channel; queue drops are counted there
+                decodePacket(plan, packet + PrimaryHeaderBytes, timestamp);
+                target.postFrame(frame);
+                ++decoded;
+                ++packets;
+            }
+            offset += PrimaryHeaderBytes + dataFieldBytes;
+        }
+        return packets;
+    }
+
+    void CcsdsDecoder::decodePacket(const Plan& plan, const std::uint8_t* field, std::int64_t timestamp) {
+        const PlanStep* step = steps.data() + plan.first;
+        const PlanStep* end = step + plan.count;
+        for (; step != end; ++step) {
+            const std::uint8_t* p = field + step->byteOffset;
+            std::uint64_t raw = 0;
+            double real = 0.0;
+            bool isFloat = false;
+
+            switch (step->op) {
+            case Op::U8:    raw = p[0]; break;
+            case Op::U16BE: raw = load16be(p); break;
+            case Op::U16LE: raw = loadLe<std::uint16_t>(p); break;
+            case Op::U32BE: raw = load32be(p); break;
+            case Op::U32LE: raw = loadLe<std::uint32_t>(p); break;
+            case Op::U64BE: raw = load64be(p); break;
+            case Op::U64LE: raw = loadLe<std::uint64_t>(p); break;
+            case Op::F32BE: {
+                const std::uint32_t bits = load32be(p);
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                real = value;
+                isFloat = true;
+                break;
+            }
+            case Op::F32LE: real = loadLe<float>(p); isFloat = true; break;
+            case Op::F64BE: {
+                const std::uint64_t bits = load64be(p);
+                std::memcpy(&real, &bits, sizeof(real));
+                isFloat = true;
+                break;
+            }
+            case Op::F64LE: real = loadLe<double>(p); isFloat = true; break;
+            case Op::BitsBE:
+                for (unsigned i = 0; i < step->byteCount; ++i) {
+                    raw = (raw << 8) | p[i];
+                }
+                raw >>= step->bitShift;
+                break;
+            case Op::BytesLE:
+                for (unsigned i = step->byteCount; i > 0; --i) {
+                    raw = (raw << 8) | p[i - 1];
+                }
+                break;
+            }
+            if (step->bitWidth < 64) {
+                raw &= (std::uint64_t(1) << step->bitWidth) - 1;
+            }
+
+            if (isFloat) {
+                frame.set(step->channel, timestamp, real * step->scale);
+                continue;
+            }
+            if (step->scale != 1.0) {
+                const double value = step->isSigned ?
+                    static_cast<double>(signExtend(raw, step->bitWidth)) : static_cast<double>(raw);
+                frame.set(step->channel, timestamp, value * step->scale);
+            }
+            else if (step->isSigned) {
+                frame.setInt(step->channel, timestamp, signExtend(raw, step->bitWidth));
+            }
+            else if (raw > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                ++saturated;
+                frame.setInt(step->channel, timestamp, std::numeric_limits<std::int64_t>::max());
+            }
+            else {
+                frame.setInt(step->channel, timestamp, static_cast<std::int64_t>(raw));
+            }
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,102 @@
+#ifndef SKYLINE_CCSDSDECODER_H
+#define SKYLINE_CCSDSDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Sample.h"
+#include "TelemetryFrame.h"
+
+namespace SkyLink {
+
+    class DataProvider;
+
+    // Decommutates CCSDS space packets. The telemetry definition (APID ->
+    // field list) is compiled once into a flat extraction plan per APID, so
+    // decoding a packet is a straight run over precomputed load operations.
+    //
+    // Definition file, one field per line, '#' starts a comment:
+    //   <apid> <channel> <bitOffset> <bitWidth> <uint|int|float> <big|little> [scale]
+    // bitOffset counts from the first bit of the packet data field (after
+    // the 6-byte primary header); bits are numbered MSB first. Unscaled
+    // integer fields are published as int64 samples; uint64 values above
+    // INT64_MAX saturate and are counted.
+    class CcsdsDecoder {
+    public:
+        enum class FieldKind : std::uint8_t { Unsigned, Signed, Float };
+
+        struct FieldDefinition {
+            std::uint16_t apid;
+            ChannelId channel;
+            std::uint32_t bitOffset;
+            std::uint8_t bitWidth;
+            FieldKind kind;
+            bool littleEndian;
+            double scale;
+        };
+
+        static const std::size_t PrimaryHeaderBytes = 6;
+        static const std::uint16_t MaxApid = 0x7FF;
+
+        CcsdsDecoder();
+
+        // Replaces the current definition; on error the previous one stays in effect
+        bool loadDefinition(const std::string& path);
+        bool addField(const FieldDefinition& field);
+        static bool isValid(const FieldDefinition& field);
+        void compile(); // rebuilds the plans; loadDefinition calls it
+
+        // Decodes every packet in buffer and posts its samples into target before
+        // the next packet is decoded, so several packets for one APID all arrive,
+        // in order. Returns the number of packets decoded.
+        std::size_t decode(const std::uint8_t* data, std::size_t size, std::int64_t timestamp, DataProvider& target);
+
+        std::uint64_t packetsDecoded() const { return decoded; }
+        std::uint64_t unknownApidPackets() const { return unknownApid; }
+        std::uint64_t shortPackets() const { return tooShort; }
+        std::uint64_t saturatedValues() const { return saturated; }
+        std::size_t fieldCount() const { return definitions.size(); }
+
+    private:
+        enum class Op : std::uint8_t {
+            U8, U16BE, U16LE, U32BE, U32LE, U64BE, U64LE,
+            F32BE, F32LE, F64BE, F64LE,
+            BitsBE, // unaligned or odd-width field, MSB-first bit order
+            BytesLE // byte-aligned little-endian field of odd byte width
+        };
+
+        struct PlanStep {
+            Op op;
+            bool isSigned;
+            std::uint8_t bitShift;   // BitsBE: right shift after loading byteCount bytes
+            std::uint8_t bitWidth;
+            std::uint8_t byteCount;  // BitsBE/BytesLE: bytes the field spans
+            std::uint32_t byteOffset;
+            ChannelId channel;
+            double scale;
+        };
+
+        struct Plan {
+            std::uint32_t first;     // into steps
+            std::uint32_t count;
+            std::uint32_t minBytes;  // data field bytes the plan touches
+        };
+
+        void decodePacket(const Plan& plan, const std::uint8_t* field, std::int64_t timestamp);
+
+        std::vector<FieldDefinition> definitions;
+        std::vector<PlanStep> steps;
+        std::vector<Plan> plans; // indexed by APID
+        ChannelId maxChannel;
+        TelemetryFrame frame; // one packet's samples, sized by compile()
+
+        std::uint64_t decoded;
+        std::uint64_t unknownApid;
+        std::uint64_t tooShort;
+        std::uint64_t saturated;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_CCSDSDECODER_H
@@ -0,0 +1,79 @@
+#include "CellLabel.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace SkyLink {
+
+    CellLabel::CellLabel() : length(0) {
+        buffer[0] = '\0';
+    }
+
+    void CellLabel::clear() {
+        length = 0;
+        buffer[0] = '\0';
+    }
+
+    void CellLabel::assign(std::string_view text) {
+        clear();
+        append(text);
+    }
+
+    void CellLabel::append(std::string_view text) {
+        std::size_t count = text.size();
+        if (count > Capacity - length) {
+            count = Capacity - length;
+        }
+        std::memcpy(buffer + length, text.data(), count);
+        length += count;
+        buffer[length] = '\0';
+    }
+
+    void CellLabel::format(const Sample& sample, const LabelStyle& style) {
+        clear();
+        append(style.prefix);
+
+        char* first = buffer + length;
+        char* last = buffer + Capacity;
+        std::to_chars_result result;
+
+        if (sample.type == SampleType::Int) {
+            result = std::to_chars(first, last, sample.intValue);
+        }
+        else {
+            switch (style.format) {
+            case LabelFormat::Integer:
+                if (std::isfinite(sample.doubleValue) && std::fabs(sample.doubleValue) < 9.0e18) {
+                    result = std::to_chars(first, last, static_cast<long long>(std::llround(sample.doubleValue)));
+                }
+                else {
+                    result = std::to_chars(first, last, sample.doubleValue, std::chars_format::fixed, 0);
+                }
+                break;
+            case LabelFormat::Scientific:
+                result = std::to_chars(first, last, sample.doubleValue, std::chars_format::scientific, style.precision);
+                break;
+            case LabelFormat::General:
+                result = std::to_chars(first, last, sample.doubleValue, std::chars_format::general, style.precision);
+                break;
+            default:
+                result = std::to_chars(first, last, sample.doubleValue, std::chars_format::fixed, style.precision);
+                break;
+            }
+        }
+
+        if (result.ec == std::errc()) {
+            length = static_cast<std::size_t>(result.ptr - buffer);
+            buffer[length] = '\0';
+        }
+        else {
+            append("###");
+        }
+
+        if (!style.units.empty()) {
+            append(" ");
+            append(style.units);
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,52 @@
+#ifndef SKYLINE_CELLLABEL_H
+#define SKYLINE_CELLLABEL_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    enum class LabelFormat {
+        Fixed,      // 12.34
+        Scientific, // 1.23e+01
+        General,    // shortest of the two
+        Integer     // rounded to a whole number
+    };
+
+    // Per-cell formatting options; set once, read on every refresh
+    struct LabelStyle {
+        std::string prefix = "Data: ";
+        std::string units;
+        int precision = 6;
+        LabelFormat format = LabelFormat::Fixed;
+    };
+
+    // Fixed-capacity inline text buffer for cell labels. Formatting goes
+    // through std::to_chars, so refreshing a label never touches the heap.
+    class CellLabel {
+    public:
+        static const std::size_t Capacity = 63;
+
+        CellLabel();
+
+        void clear();
+        void assign(std::string_view text);
+        void format(const Sample& sample, const LabelStyle& style);
+
+        std::string_view view() const { return std::string_view(buffer, length); }
+        const char* c_str() const { return buffer; }
+        std::size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+    private:
+        void append(std::string_view text);
+
+        char buffer[Capacity + 1];
+        std::size_t length;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_CELLLABEL_H
@@ -0,0 +1,76 @@
+// Label refresh along GridCell's own path: onSamples() marks the cell dirty,
+// refreshText() formats once per frame and draw() hands the view to
+// Renderer::renderText (the stand-in in BenchRenderer.cpp). The whole cycle
+// must not allocate.
+#include "Bench.h"
+#include "CellStrategy.h"
+#include "GridCell.h"
+#include "Renderer.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SkyLink {
+
+    bool benchCellLabel() {
+        const int cycles = 2000000;
+
+        LabelStyle styles[4];
+        styles[1].units = "m/s";
+        styles[1].precision = 2;
+        styles[2].format = LabelFormat::Scientific;
+        styles[2].precision = 3;
+        styles[3].format = LabelFormat::General;
+        styles[3].units = "deg";
+
+        // One cell per style, coalescing as GridSystem sets them up
+        std::vector<std::unique_ptr<GridCell>> cells;
+        for (ChannelId channel = 0; channel < 4; ++channel) {
+            cells.emplace_back(new GridCell(channel * 100.0f, 0.0f, 100.0f, 100.0f));
+            cells.back()->channel = channel;
+            cells.back()->coalesceUpdates = true;
+            cells.back()->setLabelStyle(styles[channel]);
+            cells.back()->setStrategy(new TriangleCellStrategy());
+        }
+        Renderer renderer;
+
+        const std::size_t checksumBefore = renderedChecksum();
+        const std::uint64_t allocationsBefore = allocationCount();
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < cycles; ++i) {
+            const ChannelId channel = static_cast<ChannelId>(i & 3);
+            const Sample sample = (i & 7) == 0
+                ? Sample::fromInt(channel, i, i * 37)
+                : Sample::fromDouble(channel, i, static_cast<double>(i) * 0.001234 - 1000.0);
+            GridCell& cell = *cells[channel];
+            cell.onSamples(SampleSpan(&sample, 1));
+            if (cell.dirty) {
+                cell.refreshText();
+            }
+            cell.draw(renderer);
+        }
+        const double labelSeconds = secondsSince(start);
+        const std::uint64_t labelAllocations = allocationCount() - allocationsBefore;
+        const std::size_t sink = renderedChecksum() - checksumBefore;
+
+        // The std::string path it replaced, for reference
+        std::string text;
+        std::size_t stringSink = 0;
+        const std::uint64_t stringBefore = allocationCount();
+        const auto stringStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < cycles; ++i) {
+            text = styles[0].prefix + std::to_string(static_cast<double>(i) * 0.001234 - 1000.0);
+            stringSink += text.size() + static_cast<unsigned char>(text.back());
+        }
+        const double stringSeconds = secondsSince(stringStart);
+        const std::uint64_t stringAllocations = allocationCount() - stringBefore;
+
+        std::printf("GridCell:    %.1f ns/cycle, %llu allocations in %d cycles (checksum %zu)\n",
+            labelSeconds * 1e9 / cycles, static_cast<unsigned long long>(labelAllocations), cycles, sink & 0xff);
+        std::printf("std::string: %.1f ns/cycle, %llu allocations in %d cycles (checksum %zu)\n",
+            stringSeconds * 1e9 / cycles, static_cast<unsigned long long>(stringAllocations), cycles, stringSink & 0xff);
+        return labelAllocations == 0 && sink != 0;
+    }
+
+} // namespace SkyLine
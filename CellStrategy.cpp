@@ -18,7 +18,7 @@ namespace SkyLink {
         renderer.drawTriangle(centerX, centerY, size, glm::vec3(1.0f, 0.0f, 0.0f));
 
         if (!cell.text.empty()) {
-            renderer.renderText(cell.text, cell.x + 10,
+            renderer.renderText(cell.text.view(), cell.x + 10,
                 cell.y + cell.height - 30, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
         }
     }
@@ -36,9 +36,45 @@ namespace SkyLink {
         renderer.drawTriangle(centerX, centerY, size, glm::vec3(0.0f, 0.0f, 1.0f));
 
         if (!cell.text.empty()) {
-            renderer.renderText(cell.text, cell.x + 10,
+            renderer.renderText(cell.text.view(), cell.x + 10,
                 cell.y + cell.height - 30, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
         }
     }
 
+    // TriangleYellowCellStrategy için fonksiyonlar
+    void TriangleYellowCellStrategy::update(GridCell& cell) {
+        // Güncelleme işlemleri
+    }
+
+    void TriangleYellowCellStrategy::draw(GridCell& cell, Renderer& renderer) {
+        GLfloat centerX = cell.x + cell.width / 2.0f;
+        GLfloat centerY = cell.y + cell.height / 2.0f;
+        GLfloat size = std::min(cell.width, cell.height) * 0.4f;
+
+        renderer.drawTriangle(centerX, centerY, size, glm::vec3(1.0f, 1.0f, 0.0f));
+
+        if (!cell.text.empty()) {
+            renderer.renderText(cell.text.view(), cell.x + 10,
+                cell.y + cell.height - 30, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
+        }
+    }
+
+    // CriticalCellStrategy için fonksiyonlar
+    void CriticalCellStrategy::update(GridCell& cell) {
+        // Güncelleme işlemleri
+    }
+
+    void CriticalCellStrategy::draw(GridCell& cell, Renderer& renderer) {
+        GLfloat centerX = cell.x + cell.width / 2.0f;
+        GLfloat centerY = cell.y + cell.height / 2.0f;
+        GLfloat size = std::min(cell.width, cell.height) * 0.4f;
+
+        renderer.drawTriangle(centerX, centerY, size, glm::vec3(1.0f, 0.0f, 1.0f));
+
+        if (!cell.text.empty()) {
+            renderer.renderText(cell.text.view(), cell.x + 10,
+                cell.y + cell.height - 30, 0.5f, glm::vec3(1.0f, 0.0f, 1.0f));
+        }
+    }
+
 } // namespace SkyLine
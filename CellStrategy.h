@@ -25,6 +25,19 @@ namespace SkyLink {
         void draw(GridCell& cell, Renderer& renderer) override;
     };
 
+    class TriangleYellowCellStrategy : public CellStrategy {
+    public:
+        void update(GridCell& cell) override;
+        void draw(GridCell& cell, Renderer& renderer) override;
+    };
+
+    // Critical alarm: magenta triangle and label, so it stands out from the default red triangle
+    class CriticalCellStrategy : public CellStrategy {
+    public:
+        void update(GridCell& cell) override;
+        void draw(GridCell& cell, Renderer& renderer) override;
+    };
+
 } // namespace SkyLine
 
 #endif // SKYLINE_CELLSTRATEGY_H
@@ -0,0 +1,53 @@
+#include "Crc32.h"
+#include <cstring>
+
+namespace SkyLink {
+
+    namespace {
+
+        // Slicing-by-4 tables: four bytes per lookup round
+        struct Crc32Tables {
+            std::uint32_t table[4][256];
+
+            Crc32Tables() {
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    std::uint32_t value = i;
+                    for (int bit = 0; bit < 8; ++bit) {
+                        value = (value & 1u) ? (value >> 1) ^ 0xEDB88320u : (value >> 1);
+                    }
+                    table[0][i] = value;
+                }
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    for (int slice = 1; slice < 4; ++slice) {
+                        const std::uint32_t previous = table[slice - 1][i];
+                        table[slice][i] = (previous >> 8) ^ table[0][previous & 0xFFu];
+                    }
+                }
+            }
+        };
+
+        const Crc32Tables tables;
+
+    } // namespace
+
+    std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc) {
+        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+        crc = ~crc;
+        while (size >= 4) {
+            std::uint32_t word;
+            std::memcpy(&word, bytes, 4); // little-endian hosts only
+            crc ^= word;
+            crc = tables.table[3][crc & 0xFFu] ^
+                tables.table[2][(crc >> 8) & 0xFFu] ^
+                tables.table[1][(crc >> 16) & 0xFFu] ^
+                tables.table[0][crc >> 24];
+            bytes += 4;
+            size -= 4;
+        }
+        while (size--) {
+            crc = (crc >> 8) ^ tables.table[0][(crc ^ *bytes++) & 0xFFu];
+        }
+        return ~crc;
+    }
+
+} // namespace SkyLine
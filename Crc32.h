@@ -0,0 +1,15 @@
+#ifndef SKYLINE_CRC32_H
+#define SKYLINE_CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SkyLink {
+
+    // CRC-32 (IEEE 802.3, reflected 0xEDB88320). Pass the previous result
+    // as crc to continue a running checksum over several buffers.
+    std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+} // namespace SkyLine
+
+#endif // SKYLINE_CRC32_H
@@ -1,10 +1,58 @@
 #include "DataProvider.h"
+#include <algorithm>
 
 namespace SkyLink {
 
+    DataProvider::DataProvider(std::size_t queueCapacity)
+        : queue(queueCapacity) {
+        drainBuffer.resize(queue.capacity());
+    }
+
+    void DataProvider::publish(SampleSpan samples) {
+        notifyBatch(samples);
+    }
+
     void DataProvider::setData(int newData) {
-        data = newData;
-        notify(data);
+        Sample sample = Sample::fromInt(0, nowNanoseconds(), newData);
+        publish(SampleSpan(&sample, 1));
+    }
+
+    bool DataProvider::post(const Sample& sample) {
+        return queue.push(sample);
+    }
+
+    bool DataProvider::tryPost(const Sample& sample) {
+        return queue.tryPush(sample);
+    }
+
+    std::size_t DataProvider::postFrame(TelemetryFrame& frame) {
+        std::size_t count = 0;
+        for (ChannelId channel : frame.updatedChannels()) {
+            if (queue.push(frame.sample(channel))) {
+                ++count;
+            }
+        }
+        frame.clearUpdated();
+        return count;
+    }
+
+    void DataProvider::addStage(TelemetryStage* stage) {
+        stages.push_back(stage);
+    }
+
+    void DataProvider::removeStage(TelemetryStage* stage) {
+        stages.erase(std::remove(stages.begin(), stages.end(), stage), stages.end());
+    }
+
+    std::size_t DataProvider::drain() {
+        std::size_t count = queue.popBulk(drainBuffer.data(), drainBuffer.size());
+        if (count > 0) {
+            for (TelemetryStage* stage : stages) {
+                stage->process(drainBuffer.data(), count);
+            }
+        }
+        publish(SampleSpan(drainBuffer.data(), count));
+        return count;
     }
 
 } // namespace SkyLine
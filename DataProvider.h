@@ -1,15 +1,44 @@
 #ifndef SKYLINE_DATAPROVIDER_H
 #define SKYLINE_DATAPROVIDER_H
 
+#include <cstddef>
+#include <vector>
 #include "Subject.h"
+#include "SpscQueue.h"
+#include "TelemetryFrame.h"
+#include "TelemetryStage.h"
 
 namespace SkyLink {
 
     class DataProvider : public Subject {
     public:
-        int data;
+        explicit DataProvider(std::size_t queueCapacity = 4096);
 
-        void setData(int newData);
+        // Synchronous path, notifies observers on the calling thread
+        void publish(SampleSpan samples);
+        void setData(int newData); // single int sample on channel 0
+
+        // Receiver thread: enqueue without touching observers
+        bool post(const Sample& sample);    // counts a drop when the queue is full
+        bool tryPost(const Sample& sample); // leaves retrying to the caller
+        std::size_t postFrame(TelemetryFrame& frame); // posts and clears the updated channels
+
+        // Stages run in the order added, on drained batches only
+        void addStage(TelemetryStage* stage);
+        void removeStage(TelemetryStage* stage);
+
+        // Frame loop: deliver everything queued since the last call as one batch
+        std::size_t drain();
+
+        const SpscQueue<Sample>& ingestQueue() const { return queue; }
+
+        // Consumer side for a TimestampMerger that takes over this provider as one of its sources
+        SpscQueue<Sample>& ingestQueue() { return queue; }
+
+    private:
+        SpscQueue<Sample> queue;
+        std::vector<Sample> drainBuffer;
+        std::vector<TelemetryStage*> stages;
     };
 
 } // namespace SkyLine
@@ -0,0 +1,185 @@
+#include "FlightRecorder.h"
+#include "Crc32.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <random>
+
+namespace SkyLink {
+
+    FlightRecorder::FlightRecorder()
+        : header(nullptr), segmentBytes(DefaultSegmentBytes), segmentIndex(0), sessionId(0), writeOffset(0),
+        encoding(BlockEncoding::RawSamples), samples(0), blocks(0), dropped(0), storedBytes(0) {}
+
+    FlightRecorder::~FlightRecorder() {
+        close();
+    }
+
+    bool FlightRecorder::open(const std::string& path, std::size_t bytes) {
+        close();
+        if (bytes < sizeof(RecordingHeader) + sizeof(BlockHeader) + GorillaEncoder::maxEncodedBytes(1)) {
+            std::cerr << "ERROR::FLIGHTRECORDER::Segment size too small" << std::endl;
+            return false;
+        }
+        segmentBytes = bytes;
+        return startSession(path);
+    }
+
+    bool FlightRecorder::startSession(const std::string& base) {
+        const std::time_t now = std::time(nullptr);
+        std::tm local;
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "-%Y%m%d-%H%M%S", &local);
+
+        // Two sessions in the same second get a counter
+        for (int attempt = 1; attempt < 100; ++attempt) {
+            basePath = base + stamp;
+            if (attempt > 1) {
+                char counter[8];
+                std::snprintf(counter, sizeof(counter), "-%d", attempt);
+                basePath += counter;
+            }
+            if (MappedFile::exists(recordingSegmentPath(basePath, 0))) {
+                continue;
+            }
+            // Later segments left behind without their first one would be read as part of this session
+            for (std::uint32_t index = 1; MappedFile::exists(recordingSegmentPath(basePath, index)); ++index) {
+                MappedFile::remove(recordingSegmentPath(basePath, index));
+            }
+            // Readers stop at the first segment with another id, so a stray file is never merged in
+            std::random_device random;
+            sessionId = (static_cast<std::uint64_t>(random()) << 32 | random()) ^ static_cast<std::uint64_t>(nowNanoseconds());
+            if (sessionId == 0) {
+                sessionId = 1;
+            }
+            return openSegment(0);
+        }
+        std::cerr << "ERROR::FLIGHTRECORDER::No free session name for " << base << std::endl;
+        return false;
+    }
+
+    void FlightRecorder::close() {
+        if (file.isOpen()) {
+            file.flush();
+            file.close();
+        }
+        header = nullptr;
+    }
+
+    bool FlightRecorder::openSegment(std::uint32_t index) {
+        close();
+        // Segment 0 claims the session: never replace a file some other recorder just created
+        if (!file.create(recordingSegmentPath(basePath, index), segmentBytes, index > 0)) {
+            return false;
+        }
+        segmentIndex = index;
+
+        header = reinterpret_cast<RecordingHeader*>(file.data());
+        std::memset(header, 0, sizeof(RecordingHeader));
+        std::memcpy(header->magic, RecordingMagic, sizeof(RecordingMagic));
+        header->version = RecordingVersion;
+        header->headerSize = sizeof(RecordingHeader);
+        header->capacity = segmentBytes;
+        header->createdAt = nowNanoseconds();
+        header->segmentIndex = index;
+        header->sessionId = sessionId;
+        writeOffset = sizeof(RecordingHeader);
+        headerBlockCount(*header).store(0, std::memory_order_relaxed);
+        headerTail(*header).store(writeOffset, std::memory_order_release);
+        return true;
+    }
+
+    bool FlightRecorder::appendBlock(const Sample* first, std::uint32_t count) {
+        // Reserve room for the worst case; compressed blocks are trimmed afterwards
+        const std::uint32_t rawBytes = count * static_cast<std::uint32_t>(sizeof(Sample));
+        const std::uint64_t reserveBytes = sizeof(BlockHeader) + (encoding == BlockEncoding::GorillaSamples ?
+            GorillaEncoder::maxEncodedBytes(count) : rawBytes);
+
+        if (writeOffset + reserveBytes > segmentBytes) {
+            // Segment full: roll over (the only syscalls outside open/close)
+            if (!openSegment(segmentIndex + 1)) {
+                return false;
+            }
+            if (writeOffset + reserveBytes > segmentBytes) {
+                return false;
+            }
+        }
+
+        std::uint8_t* block = file.data() + writeOffset;
+        std::uint8_t* payload = block + sizeof(BlockHeader);
+        BlockEncoding blockEncoding = encoding;
+        std::size_t payloadBytes = 0;
+        if (blockEncoding == BlockEncoding::GorillaSamples) {
+            payloadBytes = encoder.encode(first, count, payload);
+            if (payloadBytes == 0 || payloadBytes >= rawBytes) {
+                blockEncoding = BlockEncoding::RawSamples; // incompressible, or channel ids too large
+            }
+        }
+        if (blockEncoding == BlockEncoding::RawSamples) {
+            std::memcpy(payload, first, rawBytes);
+            payloadBytes = rawBytes;
+        }
+        // Keep the next block 8-byte aligned
+        while (payloadBytes % 8 != 0) {
+            payload[payloadBytes++] = 0;
+        }
+        const std::uint64_t blockBytes = sizeof(BlockHeader) + payloadBytes;
+
+        BlockHeader blockHeader;
+        blockHeader.magic = BlockMagic;
+        blockHeader.encoding = static_cast<std::uint16_t>(blockEncoding);
+        blockHeader.reserved = 0;
+        blockHeader.sampleCount = count;
+        blockHeader.payloadBytes = static_cast<std::uint32_t>(payloadBytes);
+        blockHeader.firstTimestamp = first[0].timestamp;
+        blockHeader.lastTimestamp = first[count - 1].timestamp;
+        blockHeader.crc = crc32(payload, payloadBytes);
+        blockHeader.padding = 0;
+        std::memcpy(block, &blockHeader, sizeof(BlockHeader));
+
+        writeOffset += blockBytes;
+        headerBlockCount(*header).fetch_add(1, std::memory_order_relaxed);
+        headerTail(*header).store(writeOffset, std::memory_order_release);
+
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        samples.fetch_add(count, std::memory_order_relaxed);
+        storedBytes.fetch_add(blockBytes, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool FlightRecorder::append(SampleSpan batch) {
+        if (!header) {
+            dropped.fetch_add(batch.size(), std::memory_order_relaxed);
+            return false;
+        }
+        std::size_t blockLimit = (segmentBytes - sizeof(RecordingHeader) - sizeof(BlockHeader) -
+            GorillaEncoder::maxEncodedBytes(0)) / sizeof(Sample);
+        if (blockLimit > MaxBlockSamples) {
+            blockLimit = MaxBlockSamples;
+        }
+        std::size_t offset = 0;
+        while (offset < batch.size()) {
+            std::size_t count = batch.size() - offset;
+            if (count > blockLimit) {
+                count = blockLimit;
+            }
+            if (!appendBlock(batch.data() + offset, static_cast<std::uint32_t>(count))) {
+                dropped.fetch_add(batch.size() - offset, std::memory_order_relaxed);
+                return false;
+            }
+            offset += count;
+        }
+        return true;
+    }
+
+    void FlightRecorder::onSamples(SampleSpan batch) {
+        append(batch);
+    }
+
+} // namespace SkyLine
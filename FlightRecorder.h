@@ -0,0 +1,68 @@
+#ifndef SKYLINE_FLIGHTRECORDER_H
+#define SKYLINE_FLIGHTRECORDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Observer.h"
+#include "MappedFile.h"
+#include "RecordingFormat.h"
+#include "GorillaCodec.h"
+
+namespace SkyLink {
+
+    // Append-only telemetry recorder. Sample batches are copied into a
+    // pre-allocated, memory-mapped segment file as CRC-protected blocks;
+    // when a segment fills up the recorder rolls over to the next one.
+    // Every open() starts a new session "<base>-YYYYMMDD-HHMMSS", so an
+    // earlier flight recorded under the same base is never overwritten.
+    class FlightRecorder : public Observer {
+    public:
+        static const std::size_t DefaultSegmentBytes = 256u * 1024u * 1024u;
+        static const std::uint32_t MaxBlockSamples = 4096;
+
+        FlightRecorder();
+        ~FlightRecorder();
+
+        bool open(const std::string& basePath, std::size_t segmentBytes = DefaultSegmentBytes);
+        // Base path of the current session, what RecordingReader::open() takes
+        const std::string& sessionPath() const { return basePath; }
+        // Applies to blocks written from now on; readers handle mixed segments
+        void setEncoding(BlockEncoding blockEncoding) { encoding = blockEncoding; }
+        void close();
+        bool isOpen() const { return file.isOpen(); }
+
+        bool append(SampleSpan samples);
+        void onSamples(SampleSpan samples) override;
+
+        std::uint64_t samplesWritten() const { return samples.load(std::memory_order_relaxed); }
+        std::uint64_t blocksWritten() const { return blocks.load(std::memory_order_relaxed); }
+        std::uint64_t droppedSamples() const { return dropped.load(std::memory_order_relaxed); }
+        std::uint64_t bytesWritten() const { return storedBytes.load(std::memory_order_relaxed); }
+        std::uint32_t segmentCount() const { return segmentIndex + (isOpen() ? 1 : 0); }
+
+    private:
+        bool startSession(const std::string& base);
+        bool openSegment(std::uint32_t index);
+        bool appendBlock(const Sample* first, std::uint32_t count);
+
+        MappedFile file;
+        RecordingHeader* header;
+        std::string basePath;
+        std::size_t segmentBytes;
+        std::uint32_t segmentIndex;
+        std::uint64_t sessionId;
+        std::uint64_t writeOffset;
+        BlockEncoding encoding;
+        GorillaEncoder encoder;
+
+        std::atomic<std::uint64_t> samples;
+        std::atomic<std::uint64_t> blocks;
+        std::atomic<std::uint64_t> dropped;
+        std::atomic<std::uint64_t> storedBytes;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_FLIGHTRECORDER_H
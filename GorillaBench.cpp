@@ -0,0 +1,203 @@
+// Gorilla codec round trip: a stream mixing channel jumps, int and double
+// samples on the same channels, equal, backwards and very large timestamp
+// deltas, NaNs with payloads, signed zeros and infinities must decode bit
+// for bit in blocks of any size. Every block, including one built to hit
+// the widest code of every field, must stay within maxEncodedBytes(), and
+// the encoder must not write past it. Channels at MaxChannel are refused.
+#include "Bench.h"
+#include "GorillaCodec.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::size_t StreamSamples = 200000;
+        const std::size_t Guard = 64; // bytes past the bound that must stay untouched
+        const std::uint8_t GuardByte = 0xA5;
+
+        double fromBits(std::uint64_t bits) {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        bool sameBits(const Sample& a, const Sample& b) {
+            std::uint64_t aBits;
+            std::uint64_t bBits;
+            std::memcpy(&aBits, &a.intValue, sizeof(aBits));
+            std::memcpy(&bBits, &b.intValue, sizeof(bBits));
+            return a.channel == b.channel && a.type == b.type && a.timestamp == b.timestamp && aBits == bBits;
+        }
+
+        std::vector<Sample> mixedStream() {
+            std::mt19937_64 random(20261016);
+            const double specials[] = {
+                std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::quiet_NaN(),
+                fromBits(0x7FF0000000000001ull), fromBits(0x7FF8DEADBEEF0001ull), // signalling NaN, NaN with payload
+                0.0, -0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max()
+            };
+            const std::int64_t intSpecials[] = {
+                0, -1, 1, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()
+            };
+            const std::int64_t jumps[] = {
+                -(std::int64_t(1) << 40), std::int64_t(1) << 50, -1, std::int64_t(1) << 62
+            };
+
+            std::vector<Sample> stream(StreamSamples);
+            std::vector<double> walk(300, 0.0);
+            ChannelId channel = 0;
+            std::int64_t timestamp = 1700000000000000000ll;
+            std::int64_t delta = 10000000;
+            for (Sample& sample : stream) {
+                const unsigned pick = static_cast<unsigned>(random() % 100);
+                // Channel: mostly the next one, some repeats, some jumps up to the largest id allowed
+                if (pick < 60) {
+                    channel = channel + 1 < walk.size() ? channel + 1 : 0;
+                }
+                else if (pick < 80) {
+                    channel = static_cast<ChannelId>(random() % walk.size());
+                }
+                else if (pick < 82) {
+                    channel = GorillaEncoder::MaxChannel - 1;
+                }
+                const std::size_t slot = channel < walk.size() ? channel : 0;
+
+                // Timestamp: steady, jittered, equal, backwards, or a huge jump either way
+                const unsigned step = static_cast<unsigned>(random() % 100);
+                if (step < 50) {
+                    timestamp += delta;
+                }
+                else if (step < 70) {
+                    timestamp += delta + static_cast<std::int64_t>(random() % 2001) - 1000;
+                }
+                else if (step < 85) {
+                    // equal to the previous sample
+                }
+                else if (step < 95) {
+                    timestamp -= static_cast<std::int64_t>(random() % 5000000);
+                }
+                else {
+                    timestamp = static_cast<std::int64_t>(static_cast<std::uint64_t>(timestamp) +
+                        static_cast<std::uint64_t>(jumps[random() % 4]));
+                }
+
+                // Value: ints and doubles on the same channels, repeats, walks, specials, raw bits
+                const unsigned kind = static_cast<unsigned>(random() % 100);
+                if (kind < 25) {
+                    sample = Sample::fromInt(channel, timestamp, static_cast<std::int64_t>(walk[slot]));
+                }
+                else if (kind < 30) {
+                    sample = Sample::fromInt(channel, timestamp, intSpecials[random() % 5]);
+                }
+                else if (kind < 70) {
+                    walk[slot] += static_cast<double>(static_cast<std::int64_t>(random() % 2001) - 1000) / 64.0;
+                    sample = Sample::fromDouble(channel, timestamp, walk[slot]);
+                }
+                else if (kind < 80) {
+                    sample = Sample::fromDouble(channel, timestamp, walk[slot]); // repeat
+                }
+                else if (kind < 95) {
+                    sample = Sample::fromDouble(channel, timestamp, specials[random() % 10]);
+                }
+                else {
+                    sample = Sample::fromDouble(channel, timestamp, fromBits(random()));
+                }
+            }
+            return stream;
+        }
+
+        // Alternating channels, timestamps swinging by 2^62, fresh random value windows:
+        // the longest code for channel, timestamp and value on nearly every sample
+        std::vector<Sample> widestStream() {
+            std::mt19937_64 random(42);
+            std::vector<Sample> stream(4096);
+            for (std::size_t i = 0; i < stream.size(); ++i) {
+                const std::int64_t timestamp = (i % 2 == 0) ? 0 : (std::int64_t(1) << 62);
+                const std::uint64_t bits = (random() | 1ull) | (1ull << 63);
+                stream[i] = Sample::fromDouble(i % 2 == 0 ? 7u : 40000u, timestamp, fromBits(bits));
+            }
+            return stream;
+        }
+
+        struct RoundTrip {
+            std::size_t blocks = 0;
+            std::size_t samples = 0;
+            std::size_t bytes = 0;
+            std::size_t mismatches = 0;
+            std::size_t overBound = 0; // blocks larger than maxEncodedBytes or writing past it
+            std::size_t failures = 0;  // blocks that did not encode or decode
+        };
+
+        void roundTrip(GorillaEncoder& encoder, GorillaDecoder& decoder, const Sample* samples, std::size_t count,
+            RoundTrip& result) {
+            const std::size_t bound = GorillaEncoder::maxEncodedBytes(count);
+            std::vector<std::uint8_t> encoded(bound + Guard, GuardByte);
+            const std::size_t size = encoder.encode(samples, count, encoded.data());
+            bool guardIntact = true;
+            for (std::size_t i = bound; i < encoded.size(); ++i) {
+                guardIntact = guardIntact && encoded[i] == GuardByte;
+            }
+            ++result.blocks;
+            result.samples += count;
+            result.bytes += size;
+            if (size > bound || !guardIntact) {
+                ++result.overBound;
+            }
+
+            std::vector<Sample> decoded(count);
+            if ((size == 0 && count > 0) ||
+                !decoder.decode(encoded.data(), size, count > 0 ? samples[0].timestamp : 0, count, decoded.data())) {
+                ++result.failures;
+                return;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!sameBits(samples[i], decoded[i])) {
+                    ++result.mismatches;
+                }
+            }
+        }
+
+    } // namespace
+
+    bool benchGorilla() {
+        const std::vector<Sample> stream = mixedStream();
+        const std::vector<Sample> widest = widestStream();
+        GorillaEncoder encoder;
+        GorillaDecoder decoder;
+
+        // Block sizes from one sample up, reusing the codecs so per-block resets are exercised
+        RoundTrip mixed;
+        const std::size_t sizes[] = { 1, 2, 3, 17, 256, 4096, 65536 };
+        std::size_t offset = 0;
+        for (std::size_t i = 0; offset < stream.size(); ++i) {
+            std::size_t count = sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+            count = count < stream.size() - offset ? count : stream.size() - offset;
+            roundTrip(encoder, decoder, stream.data() + offset, count, mixed);
+            offset += count;
+        }
+
+        RoundTrip worst;
+        roundTrip(encoder, decoder, widest.data(), widest.size(), worst);
+
+        std::vector<std::uint8_t> scratch(GorillaEncoder::maxEncodedBytes(2));
+        Sample tooHigh[2] = { Sample::fromInt(0, 0, 1), Sample::fromInt(GorillaEncoder::MaxChannel, 1, 2) };
+        const bool refused = encoder.encode(tooHigh, 2, scratch.data()) == 0;
+
+        std::printf("mixed: %zu samples in %zu blocks, %.2f bytes/sample, %zu mismatches, %zu over bound, %zu failed\n",
+            mixed.samples, mixed.blocks, static_cast<double>(mixed.bytes) / mixed.samples, mixed.mismatches,
+            mixed.overBound, mixed.failures);
+        std::printf("widest codes: %.2f of %.0f bytes/sample allowed, %zu mismatches, within bound: %s; "
+            "channel %u refused: %s\n", static_cast<double>(worst.bytes) / worst.samples,
+            static_cast<double>(GorillaEncoder::maxEncodedBytes(worst.samples)) / worst.samples, worst.mismatches,
+            worst.overBound == 0 ? "yes" : "no", GorillaEncoder::MaxChannel, refused ? "yes" : "no");
+        return mixed.samples == stream.size() && mixed.mismatches == 0 && mixed.overBound == 0 && mixed.failures == 0 &&
+            worst.mismatches == 0 && worst.overBound == 0 && worst.failures == 0 && refused;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,326 @@
+#include "GorillaCodec.h"
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace SkyLink {
+
+    namespace {
+
+        // Marks a channel that has no window yet; real windows have leading + trailing < 64
+        const std::uint8_t NoWindow = 0xFF;
+
+        inline unsigned leadingZeros(std::uint64_t x) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, x);
+            return 63 - static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+        }
+
+        inline unsigned trailingZeros(std::uint64_t x) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, x);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+        }
+
+        inline std::uint64_t byteSwap(std::uint64_t x) {
+#ifdef _MSC_VER
+            return _byteswap_uint64(x);
+#else
+            return __builtin_bswap64(x);
+#endif
+        }
+
+        inline std::uint64_t lowMask(unsigned bits) {
+            return bits >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+        }
+
+        inline std::int64_t signExtend(std::uint64_t value, unsigned bits) {
+            const std::uint64_t sign = std::uint64_t(1) << (bits - 1);
+            return static_cast<std::int64_t>((value ^ sign) - sign);
+        }
+
+        inline bool fitsSigned(std::int64_t value, unsigned bits) {
+            const std::int64_t limit = std::int64_t(1) << (bits - 1);
+            return value >= -limit && value < limit;
+        }
+
+        class BitWriter {
+        public:
+            explicit BitWriter(std::uint8_t* out) : out(out), start(out), acc(0), used(0) {}
+
+            void write(std::uint64_t value, unsigned bits) {
+                if (used + bits <= 64) {
+                    acc = bits == 64 ? value : (acc << bits) | value;
+                    used += bits;
+                    if (used == 64) {
+                        flushWord();
+                    }
+                    return;
+                }
+                const unsigned high = 64 - used;
+                const unsigned low = bits - high;
+                acc = (acc << high) | (value >> low);
+                flushWord();
+                acc = value & lowMask(low);
+                used = low;
+            }
+
+            // Pads the last byte with zeros; returns total bytes written
+            std::size_t finish() {
+                if (used > 0) {
+                    const std::uint64_t word = byteSwap(acc << (64 - used));
+                    std::memcpy(out, &word, (used + 7) / 8);
+                    out += (used + 7) / 8;
+                    used = 0;
+                }
+                return static_cast<std::size_t>(out - start);
+            }
+
+        private:
+            void flushWord() {
+                const std::uint64_t word = byteSwap(acc);
+                std::memcpy(out, &word, sizeof(word));
+                out += sizeof(word);
+                acc = 0;
+                used = 0;
+            }
+
+            std::uint8_t* out;
+            std::uint8_t* start;
+            std::uint64_t acc;
+            unsigned used;
+        };
+
+        class BitReader {
+        public:
+            BitReader(const std::uint8_t* data, std::size_t size)
+                : data(data), size(size), position(0), totalBits(static_cast<std::uint64_t>(size) * 8) {}
+
+            // bits in 1..56
+            std::uint64_t read(unsigned bits) {
+                const std::size_t byte = static_cast<std::size_t>(position >> 3);
+                std::uint64_t word;
+                if (byte + 8 <= size) {
+                    std::memcpy(&word, data + byte, sizeof(word));
+                    word = byteSwap(word);
+                }
+                else {
+                    word = 0;
+                    for (std::size_t i = 0; i < 8; ++i) {
+                        word = (word << 8) | (byte + i < size ? data[byte + i] : 0);
+                    }
+                }
+                word <<= (position & 7);
+                position += bits;
+                return word >> (64 - bits);
+            }
+
+            std::uint64_t readWide(unsigned bits) {
+                if (bits <= 56) {
+                    return read(bits);
+                }
+                const std::uint64_t high = read(bits - 32);
+                return (high << 32) | read(32);
+            }
+
+            bool readBit() { return read(1) != 0; }
+            bool overrun() const { return position > totalBits; }
+
+        private:
+            const std::uint8_t* data;
+            std::size_t size;
+            std::uint64_t position;
+            std::uint64_t totalBits;
+        };
+
+    } // namespace
+
+    std::size_t GorillaEncoder::encode(const Sample* samples, std::size_t count, std::uint8_t* out) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (samples[i].channel >= MaxChannel) {
+                return 0;
+            }
+        }
+        for (ChannelId channel : touched) {
+            channels[channel] = ChannelState{ 0, NoWindow, 0, false };
+        }
+        touched.clear();
+
+        BitWriter writer(out);
+        ChannelId previousChannel = ~ChannelId(0);
+        std::int64_t previousTimestamp = count > 0 ? samples[0].timestamp : 0;
+        std::int64_t previousDelta = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const Sample& sample = samples[i];
+
+            if (sample.channel == previousChannel + 1) {
+                writer.write(0, 1);
+            }
+            else if (sample.channel == previousChannel) {
+                writer.write(0x2, 2);
+            }
+            else {
+                writer.write(0x3, 2);
+                writer.write(sample.channel, 32);
+            }
+            previousChannel = sample.channel;
+
+            writer.write(sample.type == SampleType::Double ? 1 : 0, 1);
+
+            const std::int64_t delta = static_cast<std::int64_t>(
+                static_cast<std::uint64_t>(sample.timestamp) - static_cast<std::uint64_t>(previousTimestamp));
+            const std::int64_t dod = static_cast<std::int64_t>(
+                static_cast<std::uint64_t>(delta) - static_cast<std::uint64_t>(previousDelta));
+            if (dod == 0) {
+                writer.write(0, 1);
+            }
+            else if (fitsSigned(dod, 12)) {
+                writer.write(0x2, 2);
+                writer.write(static_cast<std::uint64_t>(dod) & lowMask(12), 12);
+            }
+            else if (fitsSigned(dod, 20)) {
+                writer.write(0x6, 3);
+                writer.write(static_cast<std::uint64_t>(dod) & lowMask(20), 20);
+            }
+            else if (fitsSigned(dod, 32)) {
+                writer.write(0xE, 4);
+                writer.write(static_cast<std::uint64_t>(dod) & lowMask(32), 32);
+            }
+            else {
+                writer.write(0xF, 4);
+                writer.write(static_cast<std::uint64_t>(dod), 64);
+            }
+            previousTimestamp = sample.timestamp;
+            previousDelta = delta;
+
+            if (sample.channel >= channels.size()) {
+                channels.resize(static_cast<std::size_t>(sample.channel) + 1, ChannelState{ 0, NoWindow, 0, false });
+            }
+            ChannelState& state = channels[sample.channel];
+            if (!state.touched) {
+                state.touched = true;
+                touched.push_back(sample.channel);
+            }
+
+            std::uint64_t bits;
+            std::memcpy(&bits, &sample.intValue, sizeof(bits));
+            const std::uint64_t x = bits ^ state.bits;
+            if (x == 0) {
+                writer.write(0, 1);
+            }
+            else {
+                const unsigned leading = leadingZeros(x);
+                const unsigned trailing = trailingZeros(x);
+                if (state.leading != NoWindow && leading >= state.leading && trailing >= state.trailing) {
+                    writer.write(0x2, 2);
+                    writer.write(x >> state.trailing, 64 - state.leading - state.trailing);
+                }
+                else {
+                    const unsigned meaningful = 64 - leading - trailing;
+                    writer.write(0x3, 2);
+                    writer.write(leading, 6);
+                    writer.write(meaningful - 1, 6);
+                    writer.write(x >> trailing, meaningful);
+                    state.leading = static_cast<std::uint8_t>(leading);
+                    state.trailing = static_cast<std::uint8_t>(trailing);
+                }
+            }
+            state.bits = bits;
+        }
+        return writer.finish();
+    }
+
+    bool GorillaDecoder::decode(const std::uint8_t* data, std::size_t size, std::int64_t firstTimestamp,
+        std::size_t count, Sample* out) {
+        for (ChannelId channel : touched) {
+            channels[channel] = ChannelState{ 0, NoWindow, 0, false };
+        }
+        touched.clear();
+
+        BitReader reader(data, size);
+        ChannelId channel = ~ChannelId(0);
+        std::int64_t timestamp = firstTimestamp;
+        std::int64_t delta = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!reader.readBit()) {
+                ++channel;
+            }
+            else if (reader.readBit()) {
+                channel = static_cast<ChannelId>(reader.read(32));
+            }
+            if (channel >= GorillaEncoder::MaxChannel) {
+                return false;
+            }
+
+            const bool isDouble = reader.readBit();
+
+            std::int64_t dod = 0;
+            if (reader.readBit()) {
+                if (!reader.readBit()) {
+                    dod = signExtend(reader.read(12), 12);
+                }
+                else if (!reader.readBit()) {
+                    dod = signExtend(reader.read(20), 20);
+                }
+                else if (!reader.readBit()) {
+                    dod = signExtend(reader.read(32), 32);
+                }
+                else {
+                    dod = static_cast<std::int64_t>(reader.readWide(64));
+                }
+            }
+            delta = static_cast<std::int64_t>(static_cast<std::uint64_t>(delta) + static_cast<std::uint64_t>(dod));
+            timestamp = static_cast<std::int64_t>(static_cast<std::uint64_t>(timestamp) + static_cast<std::uint64_t>(delta));
+
+            if (channel >= channels.size()) {
+                channels.resize(static_cast<std::size_t>(channel) + 1, ChannelState{ 0, NoWindow, 0, false });
+            }
+            ChannelState& state = channels[channel];
+            if (!state.touched) {
+                state.touched = true;
+                touched.push_back(channel);
+            }
+
+            if (reader.readBit()) {
+                if (!reader.readBit()) {
+                    if (state.leading == NoWindow) {
+                        return false;
+                    }
+                    const unsigned meaningful = 64 - state.leading - state.trailing;
+                    state.bits ^= reader.readWide(meaningful) << state.trailing;
+                }
+                else {
+                    const unsigned leading = static_cast<unsigned>(reader.read(6));
+                    const unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+                    if (leading + meaningful > 64) {
+                        return false;
+                    }
+                    const unsigned trailing = 64 - leading - meaningful;
+                    state.bits ^= reader.readWide(meaningful) << trailing;
+                    state.leading = static_cast<std::uint8_t>(leading);
+                    state.trailing = static_cast<std::uint8_t>(trailing);
+                }
+            }
+
+            Sample& sample = out[i];
+            sample.channel = channel;
+            sample.type = isDouble ? SampleType::Double : SampleType::Int;
+            sample.timestamp = timestamp;
+            std::memcpy(&sample.intValue, &state.bits, sizeof(state.bits));
+        }
+        return !reader.overrun();
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,66 @@
+#ifndef SKYLINE_GORILLACODEC_H
+#define SKYLINE_GORILLACODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    // Gorilla-style compression of a block of samples (BlockEncoding::GorillaSamples).
+    // Per sample, MSB-first bit stream:
+    //   channel   '0' previous + 1 | '10' same | '11' + 32 bits
+    //   type      1 bit
+    //   timestamp delta-of-delta: '0' | '10'+12 | '110'+20 | '1110'+32 | '1111'+64 bits
+    //   value     XOR with the same channel's previous value in this block:
+    //             '0' equal | '10' + bits inside the previous window |
+    //             '11' + 6 bits leading zeros + 6 bits length-1 + bits
+    // Every block starts from a clean state, so blocks decode independently.
+    // The first timestamp is not stored; it comes from the block header.
+    class GorillaEncoder {
+    public:
+        // Per-channel state is a dense table indexed by channel id, so the cap
+        // bounds it at 1 MB per codec. FlightRecorder stores blocks with larger
+        // ids raw, since encode() refuses them.
+        static const ChannelId MaxChannel = 1u << 16;
+
+        // Upper bound for encode() output, including slack for the word-wise writer
+        static std::size_t maxEncodedBytes(std::size_t count) { return count * 24 + 16; }
+
+        // Returns the number of bytes written to out, or 0 if the block cannot be encoded
+        std::size_t encode(const Sample* samples, std::size_t count, std::uint8_t* out);
+
+    private:
+        struct ChannelState {
+            std::uint64_t bits;
+            std::uint8_t leading;
+            std::uint8_t trailing;
+            bool touched;
+        };
+
+        std::vector<ChannelState> channels;
+        std::vector<ChannelId> touched;
+    };
+
+    class GorillaDecoder {
+    public:
+        // Decodes count samples; false if the stream is truncated or malformed
+        bool decode(const std::uint8_t* data, std::size_t size, std::int64_t firstTimestamp,
+            std::size_t count, Sample* out);
+
+    private:
+        struct ChannelState {
+            std::uint64_t bits;
+            std::uint8_t leading;
+            std::uint8_t trailing;
+            bool touched;
+        };
+
+        std::vector<ChannelState> channels;
+        std::vector<ChannelId> touched;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_GORILLACODEC_H
@@ -13,6 +13,18 @@
 #include <cmath>
 #include <string>
 #include <stdexcept>
+#include <cstdio>
+
+#include "DataProvider.h"
+#include "FlightRecorder.h"
+#include "UdpReceiver.h"
+#include "MavlinkDecoder.h"
+#include "TelemetryBus.h"
+#include "AlarmEngine.h"
+#include "LatestValueTable.h"
+#include "RollingStats.h"
+
+using namespace SkyLink;
 
 // Define M_PI if not defined
 #ifndef M_PI
@@ -591,6 +603,52 @@ int main()
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
+    // Telemetry data path: the receiver thread decodes MAVLink into the ingest
+    // queue, the main loop drains it once per frame
+    const ChannelId channelCount = 32;
+    DataProvider dataProvider;
+
+    // The overlay reads the latest value and statistics once per frame
+    LatestValueTable latestValues(channelCount);
+    dataProvider.addStage(&latestValues);
+    RollingStats stats(channelCount, 500);
+    dataProvider.addStage(&stats);
+
+    AlarmEngine alarms(channelCount);
+    alarms.setLimits(0, AlarmLimits{ -0.79, -0.52, 0.52, 0.79 }); // roll [rad]
+    alarms.setLimits(1, AlarmLimits{ -0.52, -0.35, 0.35, 0.52 }); // pitch [rad]
+    dataProvider.attach(&alarms);
+
+    // The recorder writes on its own thread, a disk stall drops recorded samples instead of frames
+    FlightRecorder recorder;
+    recorder.setEncoding(BlockEncoding::GorillaSamples);
+    if (recorder.open("C:/Company/GroundControl/flight")) {
+        dataProvider.attach(&recorder, BackpressurePolicy::DropNewest, 1 << 18);
+    }
+
+    // Local tools (flight dynamics, loggers, second display) read telemetry from shared memory
+    TelemetryBusPublisher bus;
+    if (bus.open(DefaultBusName, channelCount)) {
+        dataProvider.attach(&bus);
+    }
+
+    MavlinkDecoder decoder(dataProvider);
+    const ChannelId linkStatsChannel = decoder.bindCommonTelemetry(0);
+    // Radio links reorder and drop frames: release them in sequence order
+    decoder.trackSequences(16);
+    decoder.setLinkStatsChannel(linkStatsChannel);
+    UdpReceiver receiver(dataProvider);
+    receiver.setPacketHandler([&decoder](const std::uint8_t* data, std::size_t size) {
+        decoder.feed(data, size);
+        });
+    // Releases frames held behind a lost one even while the link is quiet
+    receiver.setTickHandler([&decoder]() {
+        decoder.tick();
+        });
+    if (receiver.open(14550)) {
+        receiver.start();
+    }
+
     // Data points storage
     std::vector<glm::vec2> dataPoints;
 
@@ -632,6 +690,9 @@ int main()
         // Process input/events
         glfwPollEvents();
 
+        // Deliver everything received since the last frame
+        dataProvider.drain();
+        alarms.clearTransitions(); // only level() is read here
         // Update projection matrix based on zoom and pan
         projection = glm::ortho(-1.0f * zoomLevel + panOffset.x, 1.0f * zoomLevel + panOffset.x,
             -1.0f * zoomLevel + panOffset.y, 1.0f * zoomLevel + panOffset.y,
@@ -725,6 +786,40 @@ int main()
         // Render title
         RenderText(face, "Real-Time Data Visualization", left + 0.05f * zoomLevel, top - 0.05f * zoomLevel, 0.002f * zoomLevel, glm::vec3(1.0f, 1.0f, 1.0f), textShaderProgram, projection);
 
+        // Telemetry status below the title
+        char status[160];
+        const glm::vec3 statusColor(0.8f, 0.8f, 0.8f);
+        const float statusScale = 0.0015f * zoomLevel;
+        std::uint64_t gaps = 0;
+        for (std::size_t i = 0; i < decoder.linkCount(); ++i) {
+            gaps += decoder.link(i).gapCount();
+        }
+        std::snprintf(status, sizeof(status), "Link: %llu msgs, %llu crc errors, %llu gaps",
+            static_cast<unsigned long long>(decoder.parser().messagesParsed()),
+            static_cast<unsigned long long>(decoder.parser().crcErrors()), static_cast<unsigned long long>(gaps));
+        RenderText(face, status, left + 0.05f * zoomLevel, top - 0.15f * zoomLevel, statusScale, statusColor, textShaderProgram, projection);
+
+        Sample roll;
+        RollingStats::Snapshot rollStats;
+        if (latestValues.load(0, roll) && stats.snapshot(0, rollStats)) {
+            const AlarmLevel level = alarms.level(0);
+            std::snprintf(status, sizeof(status), "Roll: %.3f rad, mean %.3f, sd %.3f%s", roll.asDouble(),
+                rollStats.mean, rollStats.stddev,
+                level == AlarmLevel::Critical ? "  CRITICAL" : level == AlarmLevel::Warning ? "  WARNING" : "");
+            const glm::vec3 rollColor = level == AlarmLevel::Critical ? glm::vec3(1.0f, 0.0f, 1.0f) :
+                level == AlarmLevel::Warning ? glm::vec3(1.0f, 1.0f, 0.0f) : statusColor;
+            RenderText(face, status, left + 0.05f * zoomLevel, top - 0.22f * zoomLevel, statusScale, rollColor, textShaderProgram, projection);
+        }
+
+        // Samples the recorder lost: dropped by its queue while the disk thread lagged, or refused by the recorder
+        if (const QueuedObserver* recorderQueue = dataProvider.queueOf(&recorder)) {
+            const std::uint64_t drops = recorderQueue->dropCount() + recorder.droppedSamples();
+            std::snprintf(status, sizeof(status), "Recorder drops: %llu (queued %zu)",
+                static_cast<unsigned long long>(drops), recorderQueue->queued());
+            RenderText(face, status, left + 0.05f * zoomLevel, top - 0.29f * zoomLevel, statusScale,
+                drops > 0 ? glm::vec3(1.0f, 0.5f, 0.0f) : statusColor, textShaderProgram, projection);
+        }
+
         // Render "X" and "Y" labels
         RenderText(face, "X", right + 0.05f * zoomLevel, -0.05f * zoomLevel, 0.002f * zoomLevel, glm::vec3(1.0f, 1.0f, 1.0f), textShaderProgram, projection);
         RenderText(face, "Y", -0.05f * zoomLevel, top + 0.05f * zoomLevel, 0.002f * zoomLevel, glm::vec3(1.0f, 1.0f, 1.0f), textShaderProgram, projection);
@@ -737,6 +832,13 @@ int main()
     }
 
     // Cleanup
+    receiver.stop();
+    decoder.flush();
+    dataProvider.drain();
+    dataProvider.detach(&recorder); // joins the recorder thread before the recorder goes away
+    recorder.close();
+    bus.close();
+
     glDeleteVertexArrays(1, &bgVAO);
     glDeleteBuffers(1, &bgVBO);
     glDeleteVertexArrays(1, &gridVAO);
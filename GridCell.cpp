@@ -1,16 +1,25 @@
 ﻿#include "GridCell.h"
 #include "DataProvider.h"
+#include "LatestValueTable.h"
 #include "Renderer.h"
 
 namespace SkyLink {
 
     GridCell::GridCell(float x, float y, float width, float height)
         : x(x), y(y), width(width), height(height),
-        active(false), data(0), dataProvider(nullptr),
-        key(-1) {} // key varsayılan olarak -1 (geçersiz tuş)
+        active(false), channel(0), data(Sample::fromInt(0, 0, 0)),
+        coalesceUpdates(false), dirty(false), latestVersion(0), dataProvider(nullptr),
+        rollingStats(nullptr), statistic(CellStatistic::Latest),
+        alarmLevel(AlarmLevel::Nominal), key(-1) {} // key varsayılan olarak -1 (geçersiz tuş)
 
     void GridCell::setStrategy(CellStrategy* strat) {
-        strategy.reset(strat);
+        // Alarm sürerken yeni strateji alarm bitince devreye girer
+        if (alarmLevel != AlarmLevel::Nominal) {
+            nominalStrategy.reset(strat);
+        }
+        else {
+            strategy.reset(strat);
+        }
     }
 
     void GridCell::update() {
@@ -25,9 +34,88 @@ namespace SkyLink {
         }
     }
 
-    void GridCell::onDataUpdated(int newData) {
-        data = newData;
-        text = "Data: " + std::to_string(data);
+    void GridCell::onSamples(SampleSpan samples) {
+        // Sadece bu tick'teki son değer çizilir
+        for (std::size_t i = samples.size(); i > 0; --i) {
+            const Sample& sample = samples[i - 1];
+            if (sample.channel == channel) {
+                data = sample;
+                if (coalesceUpdates) {
+                    dirty = true;
+                }
+                else {
+                    refreshText();
+                }
+                return;
+            }
+        }
+    }
+
+    void GridCell::sampleLatest(const LatestValueTable& table) {
+        const std::uint32_t version = table.version(channel);
+        if (version == latestVersion) {
+            return;
+        }
+        // Yazma ile çakışırsa sürüm güncellenmez, bir sonraki karede tekrar denenir
+        if (table.load(channel, data)) {
+            latestVersion = version;
+            dirty = true;
+        }
+    }
+
+    void GridCell::refreshText() {
+        RollingStats::Snapshot snapshot;
+        if (statistic != CellStatistic::Latest && rollingStats && rollingStats->snapshot(channel, snapshot)) {
+            double value = snapshot.mean;
+            switch (statistic) {
+            case CellStatistic::StdDev: value = snapshot.stddev; break;
+            case CellStatistic::Min: value = snapshot.min; break;
+            case CellStatistic::Max: value = snapshot.max; break;
+            default: break;
+            }
+            text.format(Sample::fromDouble(channel, snapshot.timestamp, value), labelStyle);
+        }
+        else {
+            text.format(data, labelStyle);
+        }
+        dirty = false;
+    }
+
+    void GridCell::setStatistic(const RollingStats* stats, CellStatistic which) {
+        rollingStats = stats;
+        statistic = which;
+        if (!text.empty()) {
+            refreshText();
+        }
+    }
+
+    void GridCell::setLabelStyle(const LabelStyle& style) {
+        labelStyle = style;
+        if (!text.empty()) {
+            refreshText();
+        }
+    }
+
+    void GridCell::setAlarmLevel(AlarmLevel level) {
+        if (level == alarmLevel) {
+            return;
+        }
+        if (alarmLevel == AlarmLevel::Nominal) {
+            nominalStrategy = std::move(strategy);
+        }
+
+        switch (level) {
+        case AlarmLevel::Nominal:
+            strategy = std::move(nominalStrategy);
+            break;
+        case AlarmLevel::Warning:
+            strategy.reset(new TriangleYellowCellStrategy());
+            break;
+        case AlarmLevel::Critical:
+            strategy.reset(new CriticalCellStrategy());
+            break;
+        }
+        alarmLevel = level;
     }
 
     void GridCell::setKeyCallback(int key, std::function<void()> callback) {
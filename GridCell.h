@@ -6,23 +6,48 @@
 #include <functional> // Callback fonksiyonları için
 #include "Observer.h"
 #include "CellStrategy.h"
+#include "CellLabel.h"
+#include "AlarmEngine.h"
+#include "RollingStats.h"
 
 namespace SkyLink {
 
     class DataProvider;
+    class LatestValueTable;
     class Renderer;
 
+    // Hücrede gösterilecek değer: son örnek ya da pencere istatistiği
+    enum class CellStatistic { Latest, Mean, StdDev, Min, Max };
+
     class GridCell : public Observer {
     public:
         float x, y;
         float width, height;
         bool active;
-        std::string text;
-        int data;
+        CellLabel text;
+        LabelStyle labelStyle;
+        ChannelId channel; // kanal numarası, sadece bu kanalın örnekleri gösterilir
+        Sample data;
+
+        // Birleştirme modu: bildirimler sadece son değeri saklar,
+        // metin GridSystem::update içinde karede bir kez üretilir
+        bool coalesceUpdates;
+        bool dirty;
+
+        // Son değer tablosundan okunan son sürüm, değişmediyse kopyalanmaz
+        std::uint32_t latestVersion;
 
         std::unique_ptr<CellStrategy> strategy;
         DataProvider* dataProvider;
 
+        // İstatistik kaynağı (opsiyonel), okuma kilitsiz
+        const RollingStats* rollingStats;
+        CellStatistic statistic;
+
+        // Alarm durumunda strateji değişir, normal strateji burada saklanır
+        AlarmLevel alarmLevel;
+        std::unique_ptr<CellStrategy> nominalStrategy;
+
         // **Yeni eklenenler**
         // Callback fonksiyonları için
         std::function<void()> onKeyCallback;
@@ -36,7 +61,12 @@ namespace SkyLink {
         void setStrategy(CellStrategy* strat);
         void update();
         void draw(Renderer& renderer);
-        void onDataUpdated(int newData) override;
+        void onSamples(SampleSpan samples) override;
+        void sampleLatest(const LatestValueTable& table); // karede bir kez, kilitsiz
+        void refreshText();
+        void setLabelStyle(const LabelStyle& style);
+        void setAlarmLevel(AlarmLevel level); // warning: sarı, critical: mor; nominal önceki stratejiye döner
+        void setStatistic(const RollingStats* stats, CellStatistic which);
 
         // **Yeni fonksiyonlar**
         void setKeyCallback(int key, std::function<void()> callback);
@@ -1,6 +1,7 @@
 #include "GridSystem.h"
 #include "Renderer.h"
 #include "CellStrategy.h"
+#include "LatestValueTable.h"
 #include <algorithm>
 
 namespace SkyLink {
@@ -26,10 +27,57 @@ namespace SkyLink {
 
     void GridSystem::update() {
         for (auto& cell : cells) {
+            if (latestValues) {
+                cell->sampleLatest(*latestValues);
+            }
+            if (cell->dirty) {
+                cell->refreshText();
+            }
             cell->update();
         }
     }
 
+    void GridSystem::setCoalescing(bool enabled) {
+        for (auto& cell : cells) {
+            cell->coalesceUpdates = enabled;
+        }
+    }
+
+    void GridSystem::setLatestValues(const LatestValueTable* table) {
+        latestValues = table;
+        for (auto& cell : cells) {
+            cell->latestVersion = 0;
+        }
+    }
+
+    void GridSystem::applyAlarms(const AlarmEngine& alarms) {
+        if (alarms.transitions().empty()) {
+            return;
+        }
+        if (channelIndexStale) {
+            reindexChannels();
+        }
+        for (const AlarmEngine::Transition& transition : alarms.transitions()) {
+            if (transition.channel >= channelCells.size()) {
+                continue;
+            }
+            for (GridCell* cell : channelCells[transition.channel]) {
+                cell->setAlarmLevel(transition.to);
+            }
+        }
+    }
+
+    void GridSystem::reindexChannels() {
+        channelCells.clear();
+        for (auto& cell : cells) {
+            if (cell->channel >= channelCells.size()) {
+                channelCells.resize(static_cast<std::size_t>(cell->channel) + 1);
+            }
+            channelCells[cell->channel].push_back(cell.get());
+        }
+        channelIndexStale = false;
+    }
+
     void GridSystem::draw(Renderer& renderer) {
         for (auto& cell : cells) {
             cell->draw(renderer);
@@ -38,10 +86,12 @@ namespace SkyLink {
 
     void GridSystem::addCell(std::shared_ptr<GridCell> cell) {
         cells.push_back(cell);
+        channelIndexStale = true;
     }
 
     void GridSystem::removeCell(std::shared_ptr<GridCell> cell) {
         cells.erase(std::remove(cells.begin(), cells.end(), cell), cells.end());
+        channelIndexStale = true;
     }
 
     std::shared_ptr<GridCell> GridSystem::getCell(int row, int col) {
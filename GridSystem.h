@@ -4,9 +4,11 @@
 #include <vector>
 #include <memory>
 #include "GridCell.h"
+#include "AlarmEngine.h"
 
 namespace SkyLink {
 
+    class LatestValueTable;
     class Renderer;
 
     class GridSystem {
@@ -18,6 +20,12 @@ namespace SkyLink {
         GridSystem(int rows, int cols);
 
         void update();
+        void setCoalescing(bool enabled);
+        // Cells read their channel from the table in update() instead of being notified
+        void setLatestValues(const LatestValueTable* table);
+        // Applies the last evaluate()'s transitions; call once per drained tick
+        void applyAlarms(const AlarmEngine& alarms);
+        void reindexChannels(); // after changing cell->channel bindings
         void draw(Renderer& renderer);
         void addCell(std::shared_ptr<GridCell> cell);
         void removeCell(std::shared_ptr<GridCell> cell);
@@ -25,6 +33,10 @@ namespace SkyLink {
 
     private:
         void createCells();
+
+        std::vector<std::vector<GridCell*>> channelCells; // channel -> cells showing it
+        bool channelIndexStale = true;
+        const LatestValueTable* latestValues = nullptr;
     };
 
 } // namespace SkyLine
@@ -0,0 +1,43 @@
+#include "LatestValueTable.h"
+#include <algorithm>
+
+namespace SkyLink {
+
+    LatestValueTable::LatestValueTable(std::size_t channelCount)
+        : channels(channelCount), slots(new Seqlock<Sample>[channelCount]),
+        writtenInBatch(channelCount, 0), batch(0) {}
+
+    void LatestValueTable::process(Sample* samples, std::size_t count) {
+        // Walk backwards so each channel is stored once, with its newest sample
+        if (++batch == 0) {
+            std::fill(writtenInBatch.begin(), writtenInBatch.end(), 0);
+            batch = 1;
+        }
+        for (std::size_t i = count; i > 0; --i) {
+            const Sample& sample = samples[i - 1];
+            if (sample.channel >= channels || writtenInBatch[sample.channel] == batch) {
+                continue;
+            }
+            writtenInBatch[sample.channel] = batch;
+            slots[sample.channel].store(sample);
+        }
+    }
+
+    void LatestValueTable::publish(const Sample& sample) {
+        if (sample.channel < channels) {
+            slots[sample.channel].store(sample);
+        }
+    }
+
+    bool LatestValueTable::load(ChannelId channel, Sample& out) const {
+        if (channel >= channels || slots[channel].version() == 0) {
+            return false;
+        }
+        return slots[channel].tryLoad(out);
+    }
+
+    std::uint32_t LatestValueTable::version(ChannelId channel) const {
+        return channel < channels ? slots[channel].version() : 0;
+    }
+
+} // namespace SkyLine
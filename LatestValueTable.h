@@ -0,0 +1,42 @@
+#ifndef SKYLINE_LATESTVALUETABLE_H
+#define SKYLINE_LATESTVALUETABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Sample.h"
+#include "Seqlock.h"
+#include "TelemetryStage.h"
+
+namespace SkyLink {
+
+    // Newest sample of every channel in a dense array indexed by channel id,
+    // one cache line per slot. Each slot is a seqlock with one writer: run the
+    // table as a DataProvider stage, or call publish() from the thread that owns
+    // the channel. Readers (the render thread) never lock and are never notified;
+    // they poll version() and load() once per frame.
+    class LatestValueTable : public TelemetryStage {
+    public:
+        explicit LatestValueTable(std::size_t channelCount);
+
+        // Only the last sample per channel in a batch is written
+        void process(Sample* samples, std::size_t count) override;
+        void publish(const Sample& sample);
+
+        // False if the channel has never been written, or a write overlapped the read
+        bool load(ChannelId channel, Sample& out) const;
+        // Completed writes to the channel, 0 if never written
+        std::uint32_t version(ChannelId channel) const;
+        std::size_t channelCount() const { return channels; }
+
+    private:
+        std::size_t channels;
+        std::unique_ptr<Seqlock<Sample>[]> slots;
+        std::vector<std::uint32_t> writtenInBatch; // batch number per channel, writer only
+        std::uint32_t batch;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_LATESTVALUETABLE_H
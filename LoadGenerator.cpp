@@ -0,0 +1,182 @@
+#include "LoadGenerator.h"
+#include "DataProvider.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace SkyLink {
+
+    namespace {
+        const double Pi = 3.14159265358979323846;
+        const std::int64_t Second = 1000ll * 1000 * 1000;
+        const std::int64_t MaxLag = Second / 10; // further behind than this, skip ahead instead of catching up
+        const std::int64_t MaxSleep = 1000ll * 1000; // 1 ms, keeps stop() responsive
+
+        struct LaterDue {
+            template <typename Due>
+            bool operator()(const Due& a, const Due& b) const { return a.time > b.time; }
+        };
+
+        double fraction(double x) {
+            return x - std::floor(x);
+        }
+    }
+
+    LoadGenerator::LoadGenerator(DataProvider& target)
+        : target(target), random(0x9E3779B97F4A7C15ull), running(false), generated(0), dropped(0), skipped(0) {}
+
+    LoadGenerator::~LoadGenerator() {
+        stop();
+    }
+
+    void LoadGenerator::addChannel(const ChannelLoad& load) {
+        ChannelState state;
+        state.load = load;
+        state.load.rate = std::min(std::max(load.rate, 1.0), 100000.0);
+        state.load.burstFactor = std::max(load.burstFactor, 1.0);
+        state.phase = fraction(static_cast<double>(channels.size()) * 0.6180339887498949);
+        state.walk = load.offset;
+        state.counter = 0;
+        state.due = 0;
+        channels.push_back(state);
+    }
+
+    void LoadGenerator::addChannels(ChannelId firstChannel, std::size_t count, const ChannelLoad& load) {
+        ChannelLoad each = load;
+        for (std::size_t i = 0; i < count; ++i) {
+            each.channel = firstChannel + static_cast<ChannelId>(i);
+            addChannel(each);
+        }
+    }
+
+    void LoadGenerator::clearChannels() {
+        stop();
+        channels.clear();
+    }
+
+    double LoadGenerator::nominalRate() const {
+        double total = 0.0;
+        for (const ChannelState& state : channels) {
+            total += state.load.rate;
+        }
+        return total;
+    }
+
+    void LoadGenerator::start() {
+        if (running.load() || channels.empty()) {
+            return;
+        }
+        // Spread first samples over one interval so channels do not fire in lockstep
+        schedule.clear();
+        for (std::uint32_t i = 0; i < channels.size(); ++i) {
+            channels[i].due = static_cast<std::int64_t>(channels[i].phase * static_cast<double>(Second) / channels[i].load.rate);
+            schedule.push_back(Due{ channels[i].due, i });
+        }
+        std::make_heap(schedule.begin(), schedule.end(), LaterDue());
+        running.store(true, std::memory_order_release);
+        worker = std::thread(&LoadGenerator::run, this);
+    }
+
+    void LoadGenerator::stop() {
+        running.store(false, std::memory_order_release);
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    double LoadGenerator::uniform() {
+        // xorshift64*, plenty for test signals
+        random ^= random >> 12;
+        random ^= random << 25;
+        random ^= random >> 27;
+        return static_cast<double>((random * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    std::int64_t LoadGenerator::interval(const ChannelLoad& load, std::int64_t time) const {
+        double rate = load.rate;
+        if (load.burstPeriod > 0.0 && load.burstLength > 0.0) {
+            const double seconds = static_cast<double>(time) / static_cast<double>(Second);
+            if (std::fmod(seconds, load.burstPeriod) < load.burstLength) {
+                rate = std::min(rate * load.burstFactor, 100000.0);
+            }
+        }
+        return std::max<std::int64_t>(1, static_cast<std::int64_t>(static_cast<double>(Second) / rate));
+    }
+
+    Sample LoadGenerator::makeSample(ChannelState& state, std::int64_t time, std::int64_t timestamp) {
+        const ChannelLoad& load = state.load;
+        const double seconds = static_cast<double>(time) / static_cast<double>(Second);
+        const double cycle = fraction(load.frequency * seconds + state.phase);
+        double value = load.offset;
+        switch (load.waveform) {
+        case Waveform::Constant:
+            break;
+        case Waveform::Sine:
+            value += load.amplitude * std::sin(2.0 * Pi * cycle);
+            break;
+        case Waveform::Square:
+            value += cycle < 0.5 ? load.amplitude : -load.amplitude;
+            break;
+        case Waveform::Sawtooth:
+            value += load.amplitude * (2.0 * cycle - 1.0);
+            break;
+        case Waveform::Noise:
+            value += load.amplitude * (2.0 * uniform() - 1.0);
+            break;
+        case Waveform::RandomWalk:
+            state.walk += 0.05 * load.amplitude * (2.0 * uniform() - 1.0);
+            value = state.walk;
+            break;
+        case Waveform::Counter:
+            return Sample::fromInt(load.channel, timestamp, state.counter++);
+        }
+        return Sample::fromDouble(load.channel, timestamp, value);
+    }
+
+    void LoadGenerator::run() {
+        typedef std::chrono::steady_clock Clock;
+        const Clock::time_point startWall = Clock::now();
+        const std::int64_t startStamp = nowNanoseconds();
+
+        while (running.load(std::memory_order_acquire)) {
+            const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startWall).count();
+
+            // Everything due by now, earliest first; only due channels are touched
+            std::uint64_t posted = 0;
+            std::uint64_t lost = 0;
+            while (!schedule.empty() && schedule.front().time <= now) {
+                std::pop_heap(schedule.begin(), schedule.end(), LaterDue());
+                Due& next = schedule.back();
+                ChannelState& state = channels[next.index];
+                if (now - state.due > MaxLag) {
+                    // Cannot keep up: drop the backlog rather than spiral
+                    const std::int64_t step = interval(state.load, state.due);
+                    const std::int64_t behind = (now - state.due) / step;
+                    skipped.store(skipped.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(behind), std::memory_order_relaxed);
+                    state.due += behind * step;
+                }
+                if (target.post(makeSample(state, state.due, startStamp + state.due))) {
+                    ++posted;
+                }
+                else {
+                    ++lost;
+                }
+                state.due += interval(state.load, state.due);
+                next.time = state.due;
+                std::push_heap(schedule.begin(), schedule.end(), LaterDue());
+            }
+            if (posted) {
+                generated.store(generated.load(std::memory_order_relaxed) + posted, std::memory_order_relaxed);
+            }
+            if (lost) {
+                dropped.store(dropped.load(std::memory_order_relaxed) + lost, std::memory_order_relaxed);
+            }
+
+            const std::int64_t wait = schedule.empty() ? MaxSleep : std::min(schedule.front().time - now, MaxSleep);
+            if (wait > 0) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+            }
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,98 @@
+#ifndef SKYLINE_LOADGENERATOR_H
+#define SKYLINE_LOADGENERATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    class DataProvider;
+
+    enum class Waveform {
+        Constant,
+        Sine,
+        Square,
+        Sawtooth,
+        Noise,      // uniform in [offset - amplitude, offset + amplitude]
+        RandomWalk,
+        Counter     // Int samples 0, 1, 2, ... so gaps show up downstream
+    };
+
+    struct ChannelLoad {
+        ChannelId channel = 0;
+        double rate = 10.0;          // samples per second, 1 Hz .. 100 kHz
+        Waveform waveform = Waveform::Sine;
+        double amplitude = 1.0;
+        double offset = 0.0;
+        double frequency = 0.5;      // waveform frequency [Hz]
+        // Every burstPeriod seconds the rate goes up by burstFactor for burstLength seconds
+        double burstPeriod = 0.0;
+        double burstLength = 0.0;
+        double burstFactor = 1.0;
+    };
+
+    // Synthetic telemetry for stress tests. Its thread posts into a DataProvider
+    // exactly like a receiver, with each sample stamped at its scheduled time.
+    // A DataProvider has one producer, so for more generator threads give each
+    // LoadGenerator its own provider and merge them with a TimestampMerger.
+    class LoadGenerator {
+    public:
+        explicit LoadGenerator(DataProvider& target);
+        ~LoadGenerator();
+
+        LoadGenerator(const LoadGenerator&) = delete;
+        LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+        // Configure before start()
+        void addChannel(const ChannelLoad& load);
+        // count channels from firstChannel on, same settings, phases spread out
+        void addChannels(ChannelId firstChannel, std::size_t count, const ChannelLoad& load);
+        void clearChannels();
+        double nominalRate() const; // samples per second outside bursts
+
+        void start();
+        void stop();
+        bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+        std::uint64_t samplesGenerated() const { return generated.load(std::memory_order_relaxed); }
+        std::uint64_t samplesDropped() const { return dropped.load(std::memory_order_relaxed); }  // ingest queue full
+        std::uint64_t samplesSkipped() const { return skipped.load(std::memory_order_relaxed); }  // generator fell behind
+
+    private:
+        struct ChannelState {
+            ChannelLoad load;
+            double phase;
+            double walk;
+            std::int64_t counter;
+            std::int64_t due; // next sample, nanoseconds since start
+        };
+
+        struct Due {
+            std::int64_t time;
+            std::uint32_t index;
+        };
+
+        void run();
+        std::int64_t interval(const ChannelLoad& load, std::int64_t time) const;
+        Sample makeSample(ChannelState& state, std::int64_t time, std::int64_t timestamp);
+        double uniform(); // [0, 1)
+
+        DataProvider& target;
+        std::vector<ChannelState> channels;
+        std::vector<Due> schedule; // min-heap on time
+        std::uint64_t random;
+
+        std::thread worker;
+        std::atomic<bool> running;
+        std::atomic<std::uint64_t> generated;
+        std::atomic<std::uint64_t> dropped;
+        std::atomic<std::uint64_t> skipped;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_LOADGENERATOR_H
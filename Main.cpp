@@ -7,9 +7,15 @@
 #include "Renderer.h"
 #include "GridSystem.h"
 #include "DataProvider.h"
+#include "FlightRecorder.h"
+#include "UdpReceiver.h"
+#include "MavlinkDecoder.h"
+#include "TelemetryBus.h"
+#include "AlarmEngine.h"
+#include "LatestValueTable.h"
+#include "RollingStats.h"
 #include "CellStrategy.h"
 #include <iostream>
-#include <random>
 #include <assimp/scene.h>
 // Dear ImGui headers
 #include "imgui.h"
@@ -470,19 +476,61 @@ int main() {
     // Create grid system
     GridSystem grid(4, 4);
     gridSystem = &grid;
+    grid.setCoalescing(true);
 
     // Create data provider
     DataProvider dataProvider;
 
-    // Attach data provider to cells
+    // Bind each cell to its own channel
+    ChannelId channelCount = 0;
     for (auto& cell : grid.cells) {
         cell->dataProvider = &dataProvider;
-        dataProvider.attach(cell.get());
+        cell->channel = channelCount++;
     }
 
-    // Random number generator
-    std::default_random_engine generator;
-    std::uniform_int_distribution<int> distribution(0, 100);
+    // Cells read their latest value once per frame in grid.update(), no per-sample notification
+    LatestValueTable latestValues(channelCount);
+    dataProvider.addStage(&latestValues);
+    grid.setLatestValues(&latestValues);
+
+    // Rolling statistics over the last 500 samples, updated as batches are drained
+    RollingStats stats(channelCount, 500);
+    dataProvider.addStage(&stats);
+    grid.getCell(0, 1)->setStatistic(&stats, CellStatistic::StdDev);
+
+    // Limit checking on every channel; cells change colour on transitions
+    AlarmEngine alarms(channelCount);
+    alarms.setLimits(0, AlarmLimits{ -0.79, -0.52, 0.52, 0.79 }); // roll [rad]
+    alarms.setLimits(1, AlarmLimits{ -0.52, -0.35, 0.35, 0.52 }); // pitch [rad]
+    dataProvider.attach(&alarms);
+
+    // Record everything the data provider delivers; the recorder writes on its own
+    // thread so a disk stall drops recorded samples instead of stalling the frame loop
+    FlightRecorder recorder;
+    recorder.setEncoding(BlockEncoding::GorillaSamples);
+    if (recorder.open("C:/Company/GroundControl/flight")) {
+        dataProvider.attach(&recorder, BackpressurePolicy::DropNewest, 1 << 18);
+    }
+
+    // Local tools (flight dynamics, loggers, second display) read telemetry from shared memory
+    TelemetryBusPublisher bus;
+    if (bus.open(DefaultBusName, channelCount)) {
+        dataProvider.attach(&bus);
+    }
+
+    // Network receiver thread decodes MAVLink into the ingest queue, the frame loop drains it
+    MavlinkDecoder decoder(dataProvider);
+    const ChannelId linkStatsChannel = decoder.bindCommonTelemetry(0);
+    // Radio links reorder and drop frames: release them in sequence order, show gaps/duplicates
+    decoder.trackSequences(16);
+    decoder.setLinkStatsChannel(linkStatsChannel);
+    UdpReceiver receiver(dataProvider);
+    receiver.setPacketHandler([&decoder](const std::uint8_t* data, std::size_t size) {
+        decoder.feed(data, size);
+        });
+    if (receiver.open(14550)) {
+        receiver.start();
+    }
 
     // **Set GLFW Callback Functions**
     glfwSetKeyCallback(window, keyCallback);
@@ -556,9 +604,10 @@ int main() {
             previousScreen = currentScreen;
         }
 
-        // Update data
-        int randomData = distribution(generator);
-        dataProvider.setData(randomData);
+        // Deliver everything received since the last frame
+        dataProvider.drain();
+        grid.applyAlarms(alarms);
+        alarms.clearTransitions();
 
         // Update grid
         grid.update();
@@ -603,6 +652,13 @@ int main() {
             currentScreen = ScreenState::VisualScripting;
         }
 
+        // Samples dropped by slow subscribers
+        if (const QueuedObserver* recorderQueue = dataProvider.queueOf(&recorder)) {
+            ImGui::SameLine();
+            ImGui::Text("Recorder drops: %llu (queued %zu)",
+                static_cast<unsigned long long>(recorderQueue->dropCount()), recorderQueue->queued());
+        }
+
         ImGui::End(); // End toolbar window
 
         // Render ImGui
@@ -638,6 +694,9 @@ int main() {
     }
 
     // **Cleanup**
+    receiver.stop();
+    dataProvider.detach(&recorder); // joins the recorder thread before the recorder goes away
+
     glDeleteProgram(shaderProgram);
     glDeleteProgram(simpleShaderProgram);
     ImGui_ImplOpenGL3_Shutdown();
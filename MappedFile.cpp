@@ -0,0 +1,207 @@
+#include "MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SkyLink {
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile()
+        : view(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+
+    bool MappedFile::create(const std::string& path, std::size_t size, bool replaceExisting) {
+        close();
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+            nullptr, replaceExisting ? CREATE_ALWAYS : CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not create " << path << std::endl;
+            return false;
+        }
+        const std::uint64_t size64 = size;
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu), nullptr);
+        if (!mapping) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not map " << path << std::endl;
+            CloseHandle(file);
+            return false;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!view) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not map view of " << path << std::endl;
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        length = size;
+        filePath = path;
+        return true;
+    }
+
+    bool MappedFile::openReadOnly(const std::string& path) {
+        close();
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not open " << path << std::endl;
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not map " << path << std::endl;
+            CloseHandle(file);
+            return false;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        length = static_cast<std::size_t>(fileSize.QuadPart);
+        filePath = path;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (view) {
+            UnmapViewOfFile(view);
+            view = nullptr;
+        }
+        if (mappingHandle) {
+            CloseHandle(mappingHandle);
+            mappingHandle = nullptr;
+        }
+        if (fileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(fileHandle);
+            fileHandle = INVALID_HANDLE_VALUE;
+        }
+        length = 0;
+    }
+
+    void MappedFile::flush() {
+        if (view) {
+            FlushViewOfFile(view, 0);
+        }
+    }
+
+    bool MappedFile::exists(const std::string& path) {
+        return GetFileAttributesA(path.c_str()) != INVALID_FILE_ATTRIBUTES;
+    }
+
+    bool MappedFile::remove(const std::string& path) {
+        return DeleteFileA(path.c_str()) != 0;
+    }
+
+#else
+
+    MappedFile::MappedFile() : view(nullptr), length(0), fileDescriptor(-1) {}
+
+    bool MappedFile::create(const std::string& path, std::size_t size, bool replaceExisting) {
+        close();
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | (replaceExisting ? O_TRUNC : O_EXCL), 0644);
+        if (fd < 0) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not create " << path << std::endl;
+            return false;
+        }
+        // Reserve the blocks up front so the hot path never extends the file
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not size " << path << std::endl;
+            ::close(fd);
+            return false;
+        }
+#ifdef __linux__
+        ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+#endif
+        void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not map " << path << std::endl;
+            ::close(fd);
+            return false;
+        }
+        fileDescriptor = fd;
+        view = mapped;
+        length = size;
+        filePath = path;
+        return true;
+    }
+
+    bool MappedFile::openReadOnly(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not open " << path << std::endl;
+            return false;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "ERROR::MAPPEDFILE::Could not map " << path << std::endl;
+            ::close(fd);
+            return false;
+        }
+        fileDescriptor = fd;
+        view = mapped;
+        length = size;
+        filePath = path;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (view) {
+            ::munmap(view, length);
+            view = nullptr;
+        }
+        if (fileDescriptor >= 0) {
+            ::close(fileDescriptor);
+            fileDescriptor = -1;
+        }
+        length = 0;
+    }
+
+    void MappedFile::flush() {
+        if (view) {
+            ::msync(view, length, MS_ASYNC);
+        }
+    }
+
+    bool MappedFile::exists(const std::string& path) {
+        struct stat info;
+        return ::stat(path.c_str(), &info) == 0;
+    }
+
+    bool MappedFile::remove(const std::string& path) {
+        return ::unlink(path.c_str()) == 0;
+    }
+
+#endif
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,52 @@
+#ifndef SKYLINE_MAPPEDFILE_H
+#define SKYLINE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SkyLink {
+
+    // Memory-mapped file, Win32 file mapping or POSIX mmap underneath
+    class MappedFile {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Creates (or truncates) the file, pre-sizes it and maps it read/write.
+        // With replaceExisting false an existing file is left alone and create() fails.
+        bool create(const std::string& path, std::size_t size, bool replaceExisting = true);
+        // Maps an existing file read-only
+        bool openReadOnly(const std::string& path);
+        void close();
+
+        static bool exists(const std::string& path);
+        static bool remove(const std::string& path);
+
+        // Schedules dirty pages for write-back without waiting for the disk
+        void flush();
+
+        bool isOpen() const { return view != nullptr; }
+        std::uint8_t* data() { return static_cast<std::uint8_t*>(view); }
+        const std::uint8_t* data() const { return static_cast<const std::uint8_t*>(view); }
+        std::size_t size() const { return length; }
+        const std::string& path() const { return filePath; }
+
+    private:
+        void* view;
+        std::size_t length;
+        std::string filePath;
+#ifdef _WIN32
+        void* fileHandle;
+        void* mappingHandle;
+#else
+        int fileDescriptor;
+#endif
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_MAPPEDFILE_H
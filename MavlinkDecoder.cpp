@@ -0,0 +1,179 @@
+#include "MavlinkDecoder.h"
+#include "DataProvider.h"
+
+namespace SkyLink {
+
+    MavlinkDecoder::MavlinkDecoder(DataProvider& target)
+        : target(target), posted(0), linkTotal(0), sequenceWindow(0), sequenceHold(SequenceTracker::DefaultMaxHold),
+        linkStats(false), linkStatsChannel(0), linkStatsInterval(0) {}
+
+    void MavlinkDecoder::bind(std::uint32_t msgid, std::uint16_t offset, FieldType type, ChannelId channel, double scale) {
+        if (msgid >= bindings.size()) {
+            bindings.resize(static_cast<std::size_t>(msgid) + 1);
+        }
+        Binding binding;
+        binding.offset = offset;
+        binding.type = type;
+        binding.channel = channel;
+        binding.scale = scale;
+        bindings[msgid].push_back(binding);
+    }
+
+    ChannelId MavlinkDecoder::bindCommonTelemetry(ChannelId channel) {
+        // ATTITUDE (30): roll, pitch, yaw [rad]
+        bind(30, 4, FieldType::Float, channel++);
+        bind(30, 8, FieldType::Float, channel++);
+        bind(30, 12, FieldType::Float, channel++);
+        // GLOBAL_POSITION_INT (33): lat, lon [deg], alt, relative_alt [m]
+        bind(33, 4, FieldType::Int32, channel++, 1e-7);
+        bind(33, 8, FieldType::Int32, channel++, 1e-7);
+        bind(33, 12, FieldType::Int32, channel++, 1e-3);
+        bind(33, 16, FieldType::Int32, channel++, 1e-3);
+        // VFR_HUD (74): airspeed, groundspeed, alt, climb
+        bind(74, 0, FieldType::Float, channel++);
+        bind(74, 4, FieldType::Float, channel++);
+        bind(74, 8, FieldType::Float, channel++);
+        bind(74, 12, FieldType::Float, channel++);
+        return channel;
+    }
+
+    void MavlinkDecoder::trackSequences(std::size_t window, std::int64_t maxHold) {
+        sequenceWindow = window;
+        sequenceHold = maxHold;
+        for (Link& link : links) {
+            link.tracker.reset();
+        }
+        linkTotal.store(0, std::memory_order_release);
+    }
+
+    void MavlinkDecoder::setLinkStatsChannel(ChannelId firstChannel, std::int64_t interval) {
+        linkStats = true;
+        linkStatsChannel = firstChannel;
+        linkStatsInterval = interval;
+        const std::size_t count = linkTotal.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            links[i].tracker->setStatsOutput(&target,
+                firstChannel + static_cast<ChannelId>(i * SequenceTracker::StatsChannels), interval);
+        }
+    }
+
+    void MavlinkDecoder::feed(const std::uint8_t* data, std::size_t size) {
+        const std::int64_t timestamp = nowNanoseconds();
+        if (sequenceWindow == 0) {
+            mavlink.parse(data, size, [this, timestamp](const MavlinkMessage& message) {
+                decode(message, timestamp);
+                });
+            return;
+        }
+        mavlink.parse(data, size, [this, timestamp](const MavlinkMessage& message) {
+            decodeInOrder(message, timestamp);
+            });
+    }
+
+    void MavlinkDecoder::tick() {
+        const std::int64_t now = nowNanoseconds();
+        const std::size_t count = linkTotal.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint16_t sender = links[i].sender;
+            links[i].tracker->tick(now,
+                [this, sender](const std::uint8_t* payload, std::size_t length, std::uint32_t msgid, std::int64_t arrival) {
+                    decodeHeld(sender, payload, length, msgid, arrival);
+                });
+        }
+    }
+
+    void MavlinkDecoder::flush() {
+        const std::size_t count = linkTotal.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint16_t sender = links[i].sender;
+            links[i].tracker->flush(
+                [this, sender](const std::uint8_t* payload, std::size_t length, std::uint32_t msgid, std::int64_t arrival) {
+                    decodeHeld(sender, payload, length, msgid, arrival);
+                });
+        }
+    }
+
+    SequenceTracker* MavlinkDecoder::linkFor(std::uint16_t sender) {
+        const std::size_t count = linkTotal.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (links[i].sender == sender) {
+                return links[i].tracker.get();
+            }
+        }
+        if (count == MaxLinks) {
+            return nullptr;
+        }
+        // Build the slot completely, then publish it to linkCount() readers
+        Link& link = links[count];
+        link.sender = sender;
+        link.tracker.reset(new SequenceTracker(8, sequenceWindow, 255, sequenceHold));
+        if (linkStats) {
+            link.tracker->setStatsOutput(&target,
+                linkStatsChannel + static_cast<ChannelId>(count * SequenceTracker::StatsChannels), linkStatsInterval);
+        }
+        linkTotal.store(count + 1, std::memory_order_release);
+        return link.tracker.get();
+    }
+
+    void MavlinkDecoder::decodeInOrder(const MavlinkMessage& message, std::int64_t timestamp) {
+        const std::uint16_t sender = static_cast<std::uint16_t>((message.systemId << 8) | message.componentId);
+        SequenceTracker* tracker = linkFor(sender);
+        if (!tracker) {
+            decode(message, timestamp);
+            return;
+        }
+
+        // Held frames only keep their payload; the message id rides along as the tag
+        tracker->receive(message.sequence, message.payload, message.payloadLength, message.msgid, timestamp,
+            [this, sender](const std::uint8_t* payload, std::size_t length, std::uint32_t msgid, std::int64_t arrival) {
+                decodeHeld(sender, payload, length, msgid, arrival);
+            });
+    }
+
+    void MavlinkDecoder::decodeHeld(std::uint16_t sender, const std::uint8_t* payload, std::size_t length,
+        std::uint32_t msgid, std::int64_t arrival) {
+        MavlinkMessage held = {};
+        held.msgid = msgid;
+        held.systemId = static_cast<std::uint8_t>(sender >> 8);
+        held.componentId = static_cast<std::uint8_t>(sender);
+        held.payload = payload;
+        held.payloadLength = static_cast<std::uint8_t>(length);
+        decode(held, arrival);
+    }
+
+    void MavlinkDecoder::decode(const MavlinkMessage& message, std::int64_t timestamp) {
+        if (message.msgid >= bindings.size()) {
+            return;
+        }
+        for (const Binding& binding : bindings[message.msgid]) {
+            std::int64_t integer = 0;
+            double real = 0.0;
+            bool isInteger = true;
+            switch (binding.type) {
+            case FieldType::UInt8:  integer = message.field<std::uint8_t>(binding.offset); break;
+            case FieldType::Int8:   integer = message.field<std::int8_t>(binding.offset); break;
+            case FieldType::UInt16: integer = message.field<std::uint16_t>(binding.offset); break;
+            case FieldType::Int16:  integer = message.field<std::int16_t>(binding.offset); break;
+            case FieldType::UInt32: integer = message.field<std::uint32_t>(binding.offset); break;
+            case FieldType::Int32:  integer = message.field<std::int32_t>(binding.offset); break;
+            case FieldType::UInt64: integer = static_cast<std::int64_t>(message.field<std::uint64_t>(binding.offset)); break;
+            case FieldType::Int64:  integer = message.field<std::int64_t>(binding.offset); break;
+            case FieldType::Float:  real = message.field<float>(binding.offset); isInteger = false; break;
+            case FieldType::Double: real = message.field<double>(binding.offset); isInteger = false; break;
+            }
+
+            Sample sample;
+            if (isInteger && binding.scale == 1.0) {
+                sample = Sample::fromInt(binding.channel, timestamp, integer);
+            }
+            else {
+                const double value = isInteger ? static_cast<double>(integer) : real;
+                sample = Sample::fromDouble(binding.channel, timestamp, value * binding.scale);
+            }
+            if (target.post(sample)) {
+                ++posted;
+            }
+        }
+    }
+
+} // namespace SkyLine
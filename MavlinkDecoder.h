@@ -0,0 +1,93 @@
+#ifndef SKYLINE_MAVLINKDECODER_H
+#define SKYLINE_MAVLINKDECODER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "MavlinkParser.h"
+#include "Sample.h"
+#include "SequenceTracker.h"
+
+namespace SkyLink {
+
+    class DataProvider;
+
+    enum class FieldType : std::uint8_t {
+        UInt8, Int8, UInt16, Int16, UInt32, Int32, UInt64, Int64, Float, Double
+    };
+
+    // Turns MAVLink fields into typed Samples on fixed channels and posts
+    // them into a DataProvider, which routes them to the channel subscribers.
+    class MavlinkDecoder {
+    public:
+        static const std::size_t MaxLinks = 16; // senders beyond this are decoded without reordering
+
+        explicit MavlinkDecoder(DataProvider& target);
+
+        // offset is the field's byte offset in the (wire-ordered) payload
+        void bind(std::uint32_t msgid, std::uint16_t offset, FieldType type, ChannelId channel, double scale = 1.0);
+        // ATTITUDE, GLOBAL_POSITION_INT and VFR_HUD on consecutive channels, returns the next free channel
+        ChannelId bindCommonTelemetry(ChannelId firstChannel);
+
+        // Put each sender's (system/component id) frames back in sequence order before
+        // decoding; window 0 turns tracking off. Call before the receive thread starts.
+        void trackSequences(std::size_t window, std::int64_t maxHold = SequenceTracker::DefaultMaxHold);
+        // Sender n posts its link statistics on firstChannel + n * SequenceTracker::StatsChannels
+        void setLinkStatsChannel(ChannelId firstChannel, std::int64_t interval = 1000ll * 1000 * 1000);
+
+        // Receive thread: parse a chunk of the byte stream and post its samples
+        void feed(const std::uint8_t* data, std::size_t size);
+        // Receive thread, between feeds: decode frames held behind a gap that has
+        // waited maxHold and post due link statistics, also while no bytes arrive.
+        // Pass it as the receiver's tick handler so feed() stays the only producer.
+        void tick();
+        // Decode everything still held, skipping the gaps (end of stream). Call
+        // after the receive thread stopped.
+        void flush();
+
+        MavlinkParser& parser() { return mavlink; }
+        const MavlinkParser& parser() const { return mavlink; }
+        std::uint64_t samplesPosted() const { return posted; }
+        // Any thread: a link below linkCount() is fully built and stays where it is
+        std::size_t linkCount() const { return linkTotal.load(std::memory_order_acquire); }
+        const SequenceTracker& link(std::size_t index) const { return *links[index].tracker; }
+
+    private:
+        struct Binding {
+            std::uint16_t offset;
+            FieldType type;
+            ChannelId channel;
+            double scale;
+        };
+
+        struct Link {
+            std::uint16_t sender; // systemId << 8 | componentId
+            std::unique_ptr<SequenceTracker> tracker;
+        };
+
+        void decode(const MavlinkMessage& message, std::int64_t timestamp);
+        void decodeInOrder(const MavlinkMessage& message, std::int64_t timestamp);
+        void decodeHeld(std::uint16_t sender, const std::uint8_t* payload, std::size_t length,
+            std::uint32_t msgid, std::int64_t arrival);
+        SequenceTracker* linkFor(std::uint16_t sender);
+
+        DataProvider& target;
+        MavlinkParser mavlink;
+        std::vector<std::vector<Binding>> bindings; // by msgid
+        std::uint64_t posted;
+
+        std::array<Link, MaxLinks> links; // a new sender allocates its tracker once, then never again
+        std::atomic<std::size_t> linkTotal; // written by the receive thread only
+        std::size_t sequenceWindow;
+        std::int64_t sequenceHold;
+        bool linkStats;
+        ChannelId linkStatsChannel;
+        std::int64_t linkStatsInterval;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_MAVLINKDECODER_H
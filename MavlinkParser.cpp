@@ -0,0 +1,159 @@
+#include "MavlinkParser.h"
+
+namespace SkyLink {
+
+    namespace {
+
+        struct MavlinkCrcTable {
+            std::uint16_t table[256];
+
+            MavlinkCrcTable() {
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    std::uint16_t crc = static_cast<std::uint16_t>(i);
+                    for (int bit = 0; bit < 8; ++bit) {
+                        crc = (crc & 1u) ? static_cast<std::uint16_t>((crc >> 1) ^ 0x8408u) : static_cast<std::uint16_t>(crc >> 1);
+                    }
+                    table[i] = crc;
+                }
+            }
+        };
+
+        const MavlinkCrcTable crcTable;
+
+        // CRC_EXTRA seeds from common.xml for the telemetry we usually see
+        const struct { std::uint32_t msgid; std::uint8_t extra; } CommonCrcExtras[] = {
+            { 0, 50 },    // HEARTBEAT
+            { 1, 124 },   // SYS_STATUS
+            { 2, 137 },   // SYSTEM_TIME
+            { 4, 237 },   // PING
+            { 22, 220 },  // PARAM_VALUE
+            { 24, 24 },   // GPS_RAW_INT
+            { 26, 170 },  // SCALED_IMU
+            { 27, 144 },  // RAW_IMU
+            { 29, 115 },  // SCALED_PRESSURE
+            { 30, 39 },   // ATTITUDE
+            { 31, 246 },  // ATTITUDE_QUATERNION
+            { 32, 185 },  // LOCAL_POSITION_NED
+            { 33, 104 },  // GLOBAL_POSITION_INT
+            { 36, 222 },  // SERVO_OUTPUT_RAW
+            { 42, 28 },   // MISSION_CURRENT
+            { 62, 183 },  // NAV_CONTROLLER_OUTPUT
+            { 65, 118 },  // RC_CHANNELS
+            { 74, 20 },   // VFR_HUD
+            { 76, 152 },  // COMMAND_LONG
+            { 77, 143 },  // COMMAND_ACK
+            { 105, 93 },  // HIGHRES_IMU
+            { 111, 34 },  // TIMESYNC
+            { 116, 76 },  // SCALED_IMU2
+            { 125, 203 }, // POWER_STATUS
+            { 147, 154 }, // BATTERY_STATUS
+            { 230, 163 }, // ESTIMATOR_STATUS
+            { 241, 90 },  // VIBRATION
+            { 253, 83 }   // STATUSTEXT
+        };
+
+    } // namespace
+
+    std::uint16_t mavlinkCrcAccumulate(std::uint8_t byte, std::uint16_t crc) {
+        return static_cast<std::uint16_t>((crc >> 8) ^ crcTable.table[(crc ^ byte) & 0xFFu]);
+    }
+
+    std::uint16_t mavlinkCrc(const std::uint8_t* data, std::size_t size, std::uint16_t crc) {
+        for (std::size_t i = 0; i < size; ++i) {
+            crc = static_cast<std::uint16_t>((crc >> 8) ^ crcTable.table[(crc ^ data[i]) & 0xFFu]);
+        }
+        return crc;
+    }
+
+    MavlinkParser::MavlinkParser()
+        : pendingLength(0), parsed(0), badCrc(0), unknown(0), discarded(0) {
+        crcExtras.assign(256, -1);
+        for (const auto& entry : CommonCrcExtras) {
+            crcExtras[entry.msgid] = entry.extra;
+        }
+    }
+
+    void MavlinkParser::setCrcExtra(std::uint32_t msgid, std::uint8_t extra) {
+        if (msgid >= crcExtras.size()) {
+            crcExtras.resize(static_cast<std::size_t>(msgid) + 1, -1);
+        }
+        crcExtras[msgid] = extra;
+    }
+
+    std::size_t MavlinkParser::findStx(const std::uint8_t* data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (data[i] == StxV1 || data[i] == StxV2) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    void MavlinkParser::dropPendingByte() {
+        const std::size_t next = 1 + findStx(pending + 1, pendingLength - 1);
+        bump(discarded, next);
+        pendingLength -= next;
+        std::memmove(pending, pending + next, pendingLength);
+    }
+
+    int MavlinkParser::checkFrame(const std::uint8_t* frame, std::size_t available, MavlinkMessage& message) {
+        std::size_t headerBytes;
+        std::size_t frameBytes;
+        const std::uint8_t payloadLength = available > 1 ? frame[1] : 0;
+
+        if (frame[0] == StxV1) {
+            headerBytes = 6;
+            if (available < headerBytes) {
+                return NeedMore;
+            }
+            frameBytes = headerBytes + payloadLength + 2;
+            message.version = 1;
+            message.sequence = frame[2];
+            message.systemId = frame[3];
+            message.componentId = frame[4];
+            message.msgid = frame[5];
+        }
+        else {
+            headerBytes = 10;
+            if (available < headerBytes) {
+                return NeedMore;
+            }
+            const std::uint8_t incompatFlags = frame[2];
+            if (incompatFlags & ~0x01u) {
+                return Invalid; // unsupported feature, most likely not a real STX
+            }
+            frameBytes = headerBytes + payloadLength + 2 + ((incompatFlags & 0x01u) ? 13 : 0);
+            message.version = 2;
+            message.sequence = frame[4];
+            message.systemId = frame[5];
+            message.componentId = frame[6];
+            message.msgid = static_cast<std::uint32_t>(frame[7]) |
+                (static_cast<std::uint32_t>(frame[8]) << 8) |
+                (static_cast<std::uint32_t>(frame[9]) << 16);
+        }
+
+        if (available < frameBytes) {
+            return NeedMore;
+        }
+
+        const int extra = message.msgid < crcExtras.size() ? crcExtras[message.msgid] : -1;
+        if (extra < 0) {
+            bump(unknown);
+            return Invalid;
+        }
+
+        std::uint16_t crc = mavlinkCrc(frame + 1, headerBytes - 1 + payloadLength);
+        crc = mavlinkCrcAccumulate(static_cast<std::uint8_t>(extra), crc);
+        const std::uint8_t* checksum = frame + headerBytes + payloadLength;
+        if ((checksum[0] | (checksum[1] << 8)) != crc) {
+            bump(badCrc);
+            return Invalid;
+        }
+
+        message.payload = frame + headerBytes;
+        message.payloadLength = payloadLength;
+        bump(parsed);
+        return static_cast<int>(frameBytes);
+    }
+
+} // namespace SkyLine
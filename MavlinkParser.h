@@ -0,0 +1,172 @@
+#ifndef SKYLINE_MAVLINKPARSER_H
+#define SKYLINE_MAVLINKPARSER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace SkyLink {
+
+    // A decoded MAVLink frame. payload points into the caller's receive
+    // buffer (or the parser's carry-over buffer for frames split across
+    // reads) and is only valid inside the message callback.
+    struct MavlinkMessage {
+        std::uint32_t msgid;
+        std::uint8_t version; // 1 or 2
+        std::uint8_t sequence;
+        std::uint8_t systemId;
+        std::uint8_t componentId;
+        const std::uint8_t* payload;
+        std::uint8_t payloadLength;
+
+        // Little-endian field read; bytes cut by v2 payload truncation read as zero
+        template <typename T>
+        T field(std::size_t offset) const {
+            T value;
+            if (offset + sizeof(T) <= payloadLength) {
+                std::memcpy(&value, payload + offset, sizeof(T));
+                return value;
+            }
+            std::uint8_t bytes[sizeof(T)] = {};
+            if (offset < payloadLength) {
+                std::memcpy(bytes, payload + offset, payloadLength - offset);
+            }
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+    };
+
+    // CRC-16/MCRF4XX (X.25) as used by MAVLink, table driven
+    std::uint16_t mavlinkCrc(const std::uint8_t* data, std::size_t size, std::uint16_t crc = 0xFFFF);
+    std::uint16_t mavlinkCrcAccumulate(std::uint8_t byte, std::uint16_t crc);
+
+    // Streaming MAVLink v1/v2 frame parser. Feed it arbitrary chunks of a
+    // byte stream; it resynchronises on STX bytes, checks CRC + CRC_EXTRA
+    // and calls onMessage(const MavlinkMessage&) for every valid frame.
+    // parse() runs on one thread; the counters are single-writer atomics the
+    // UI may read.
+    class MavlinkParser {
+    public:
+        static const std::uint8_t StxV1 = 0xFE;
+        static const std::uint8_t StxV2 = 0xFD;
+        static const std::size_t MaxFrameBytes = 10 + 255 + 2 + 13;
+
+        MavlinkParser(); // knows the CRC_EXTRA of the common telemetry messages
+
+        // Register a dialect message. A frame whose id has no CRC_EXTRA can not be
+        // verified, so its STX is treated like a false one and the parser
+        // resynchronises on the next STX byte inside it.
+        void setCrcExtra(std::uint32_t msgid, std::uint8_t extra);
+
+        template <typename Handler>
+        void parse(const std::uint8_t* data, std::size_t size, Handler&& onMessage);
+        void reset() { pendingLength = 0; }
+
+        std::uint64_t messagesParsed() const { return parsed.load(std::memory_order_relaxed); }
+        std::uint64_t crcErrors() const { return badCrc.load(std::memory_order_relaxed); }
+        // STX candidates with an unregistered id: unknown dialect frames and false STX bytes alike
+        std::uint64_t unknownIds() const { return unknown.load(std::memory_order_relaxed); }
+        std::uint64_t bytesDiscarded() const { return discarded.load(std::memory_order_relaxed); }
+
+    private:
+        enum { NeedMore = 0, Invalid = -1 };
+
+        // >0: frame length, NeedMore: frame incomplete, Invalid: not a frame at this STX
+        int checkFrame(const std::uint8_t* frame, std::size_t available, MavlinkMessage& message);
+        static std::size_t findStx(const std::uint8_t* data, std::size_t size);
+        void dropPendingByte();
+
+        // Only parse() writes, so a relaxed load and store is enough
+        static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        std::vector<std::int16_t> crcExtras; // by msgid, -1 = unknown
+        std::uint8_t pending[MaxFrameBytes];
+        std::size_t pendingLength;
+
+        std::atomic<std::uint64_t> parsed;
+        std::atomic<std::uint64_t> badCrc;
+        std::atomic<std::uint64_t> unknown;
+        std::atomic<std::uint64_t> discarded;
+    };
+
+    template <typename Handler>
+    void MavlinkParser::parse(const std::uint8_t* data, std::size_t size, Handler&& onMessage) {
+        MavlinkMessage message;
+        std::size_t offset = 0;
+
+        // Finish a frame that started in a previous chunk
+        while (pendingLength > 0) {
+            // Bytes left behind a completed frame need not start with an STX
+            if (pending[0] != StxV1 && pending[0] != StxV2) {
+                dropPendingByte();
+                continue;
+            }
+            const int result = checkFrame(pending, pendingLength, message);
+            if (result > 0) {
+                onMessage(static_cast<const MavlinkMessage&>(message));
+                // Hand back bytes that belong to the next frame so they are parsed in place
+                const std::size_t extra = pendingLength - static_cast<std::size_t>(result);
+                if (extra <= offset) {
+                    offset -= extra;
+                    pendingLength = 0;
+                }
+                else {
+                    pendingLength = extra;
+                    std::memmove(pending, pending + result, pendingLength);
+                }
+                continue;
+            }
+            if (result == Invalid) {
+                dropPendingByte();
+                continue;
+            }
+            if (offset == size) {
+                return;
+            }
+            // Top up one byte at a time until the header tells us the length, then in bulk
+            std::size_t take = 1;
+            if (pendingLength >= 10 || (pending[0] == StxV1 && pendingLength >= 6)) {
+                take = MaxFrameBytes - pendingLength;
+            }
+            if (take > size - offset) {
+                take = size - offset;
+            }
+            std::memcpy(pending + pendingLength, data + offset, take);
+            pendingLength += take;
+            offset += take;
+        }
+
+        // Zero-copy path over the caller's buffer
+        while (offset < size) {
+            const std::size_t skip = findStx(data + offset, size - offset);
+            if (skip > 0) {
+                bump(discarded, skip);
+            }
+            offset += skip;
+            if (offset == size) {
+                return;
+            }
+            const int result = checkFrame(data + offset, size - offset, message);
+            if (result > 0) {
+                onMessage(static_cast<const MavlinkMessage&>(message));
+                offset += static_cast<std::size_t>(result);
+            }
+            else if (result == Invalid) {
+                bump(discarded);
+                ++offset;
+            }
+            else {
+                pendingLength = size - offset;
+                std::memcpy(pending, data + offset, pendingLength);
+                return;
+            }
+        }
+    }
+
+} // namespace SkyLine
+
+#endif // SKYLINE_MAVLINKPARSER_H
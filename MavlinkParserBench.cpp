@@ -0,0 +1,101 @@
+// MAVLink parser over a recorded link: data/mavlink-capture.bin holds 30 s of
+// two vehicles (one v1, one v2 with truncated payloads) at 100 Hz. Every 5 s
+// a false STX claims a long frame that swallows line noise, a heartbeat and
+// a run of idle zero bytes. Split into chunks of any size the capture must
+// yield the same frames and error counts as in one piece, and the parser
+// must sustain more than 1M messages/s without touching the heap. Run from
+// the repo root.
+#include "Bench.h"
+#include "MavlinkParser.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const CapturePath = "data/mavlink-capture.bin";
+        const std::uint64_t CaptureMessages = 8226;
+        const std::uint64_t CaptureNoiseBursts = 6;
+        const std::size_t DatagramBytes = 1500;
+        const int ThroughputPasses = 200;
+
+        struct Digest {
+            std::uint64_t messages = 0;
+            std::uint64_t hash = 0;
+            std::uint64_t crcErrors = 0;
+            std::uint64_t unknown = 0;
+
+            bool operator==(const Digest& other) const {
+                return messages == other.messages && hash == other.hash &&
+                    crcErrors == other.crcErrors && unknown == other.unknown;
+            }
+        };
+
+        Digest parseInChunks(const std::vector<std::uint8_t>& capture, std::size_t chunk) {
+            MavlinkParser parser;
+            Digest digest;
+            for (std::size_t offset = 0; offset < capture.size(); offset += chunk) {
+                const std::size_t size = capture.size() - offset < chunk ? capture.size() - offset : chunk;
+                parser.parse(capture.data() + offset, size, [&digest](const MavlinkMessage& message) {
+                    ++digest.messages;
+                    digest.hash = digest.hash * 31 + (message.msgid << 16 | message.systemId << 8 | message.sequence);
+                    digest.hash = digest.hash * 31 + message.field<std::uint32_t>(0);
+                });
+            }
+            digest.crcErrors = parser.crcErrors();
+            digest.unknown = parser.unknownIds();
+            return digest;
+        }
+
+    } // namespace
+
+    bool benchMavlinkParser() {
+        std::ifstream file(CapturePath, std::ios::binary);
+        if (!file) {
+            std::printf("%s not found\n", CapturePath);
+            return false;
+        }
+        const std::vector<std::uint8_t> capture((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        const Digest whole = parseInChunks(capture, capture.size());
+        bool chunksAgree = true;
+        for (std::size_t chunk : { std::size_t(1), std::size_t(7), std::size_t(64), DatagramBytes }) {
+            const Digest split = parseInChunks(capture, chunk);
+            if (!(split == whole)) {
+                std::printf("%zu-byte chunks: %llu messages, %llu crc errors, %llu unknown\n", chunk,
+                    static_cast<unsigned long long>(split.messages), static_cast<unsigned long long>(split.crcErrors),
+                    static_cast<unsigned long long>(split.unknown));
+                chunksAgree = false;
+            }
+        }
+
+        MavlinkParser parser;
+        std::uint64_t sink = 0;
+        const std::uint64_t allocationsBefore = allocationCount();
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < ThroughputPasses; ++pass) {
+            for (std::size_t offset = 0; offset < capture.size(); offset += DatagramBytes) {
+                const std::size_t size = capture.size() - offset < DatagramBytes ? capture.size() - offset : DatagramBytes;
+                parser.parse(capture.data() + offset, size, [&sink](const MavlinkMessage& message) {
+                    sink += message.msgid + message.field<std::uint32_t>(0);
+                });
+            }
+        }
+        const double seconds = secondsSince(start);
+        const std::uint64_t allocations = allocationCount() - allocationsBefore;
+        const double rate = parser.messagesParsed() / seconds;
+
+        std::printf("%llu messages, %llu crc errors in %zu bytes; chunked parses agree: %s\n",
+            static_cast<unsigned long long>(whole.messages), static_cast<unsigned long long>(whole.crcErrors),
+            capture.size(), chunksAgree ? "yes" : "no");
+        std::printf("%.2f M messages/s, %.0f MB/s, %llu allocations (sink %llu)\n", rate / 1e6,
+            capture.size() * ThroughputPasses / seconds / 1e6, static_cast<unsigned long long>(allocations),
+            static_cast<unsigned long long>(sink));
+        return whole.messages == CaptureMessages && whole.crcErrors == CaptureNoiseBursts && whole.unknown == 0 &&
+            chunksAgree && allocations == 0 && rate > 1e6;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,153 @@
+// Timestamp merger: three jittered sources within their lateness must come
+// out as one time-ordered stream with nothing forced or dropped, while
+// samples posted behind the merged stream are counted late and left out.
+// A source whose window fills up while another source holds the oldest head
+// must force that head out rather than stall, so its own ingest queue keeps
+// draining and never drops; the forced releases are counted.
+#include "Bench.h"
+#include "TimestampMerger.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::int64_t Millisecond = 1000ll * 1000;
+        const std::int64_t Second = 1000 * Millisecond;
+
+        class Collector : public Observer {
+        public:
+            std::vector<Sample> samples;
+
+            void onSamples(SampleSpan batch) override {
+                samples.insert(samples.end(), batch.begin(), batch.end());
+            }
+        };
+
+        bool inOrder(const std::vector<Sample>& samples) {
+            for (std::size_t i = 1; i < samples.size(); ++i) {
+                if (samples[i].timestamp < samples[i - 1].timestamp) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::uint64_t totalDrops(DataProvider* providers, std::size_t count) {
+            std::uint64_t drops = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                drops += providers[i].ingestQueue().dropCount();
+            }
+            return drops;
+        }
+
+        // Three links at 1 kHz each, every sample up to 40 ms out of place, lateness 50 ms
+        bool jitteredSources() {
+            const std::size_t Sources = 3;
+            const std::size_t PerSource = 20000;
+            const std::int64_t Jitter = 40 * Millisecond;
+            const std::size_t LatePosts = 5;
+            std::mt19937_64 random(7);
+
+            DataProvider providers[Sources];
+            DataProvider output(Sources * PerSource);
+            Collector collector;
+            output.attach(&collector);
+            TimestampMerger merger;
+            for (DataProvider& provider : providers) {
+                merger.addSource(provider, 50 * Millisecond);
+            }
+
+            std::int64_t now = 0;
+            std::size_t latePosted = 0;
+            for (std::size_t round = 0; round * 100 < PerSource; ++round) {
+                for (std::size_t s = 0; s < Sources; ++s) {
+                    for (std::size_t i = round * 100; i < (round + 1) * 100; ++i) {
+                        const std::int64_t t = static_cast<std::int64_t>(i) * Millisecond +
+                            static_cast<std::int64_t>(random() % Jitter);
+                        providers[s].post(Sample::fromInt(static_cast<ChannelId>(s), t, static_cast<std::int64_t>(i)));
+                    }
+                }
+                // Now and then a sample far behind what already went out
+                if (round % 40 == 39 && latePosted < LatePosts) {
+                    providers[round % Sources].post(Sample::fromInt(9, merger.lastReleased() - Second, -1));
+                    ++latePosted;
+                }
+                merger.pump(output, now);
+                now += Millisecond;
+            }
+            // Every source goes quiet, which releases the rest
+            merger.pump(output, now + TimestampMerger::DefaultIdleTimeout + 1);
+            output.drain();
+
+            std::uint64_t received = 0;
+            std::uint64_t late = 0;
+            std::uint64_t forced = 0;
+            for (std::size_t s = 0; s < Sources; ++s) {
+                received += merger.stats(s).received;
+                late += merger.stats(s).late;
+                forced += merger.stats(s).forced;
+            }
+            const bool ordered = inOrder(collector.samples);
+            const std::uint64_t drops = totalDrops(providers, Sources) + output.ingestQueue().dropCount();
+            std::printf("jittered: %zu of %zu samples out, in order: %s; late %llu of %zu, forced %llu, "
+                "buffered %zu, dropped %llu\n", collector.samples.size(), Sources * PerSource, ordered ? "yes" : "no",
+                static_cast<unsigned long long>(late), latePosted, static_cast<unsigned long long>(forced),
+                merger.buffered(), static_cast<unsigned long long>(drops));
+            return ordered && collector.samples.size() == Sources * PerSource && received == Sources * PerSource + latePosted &&
+                late == latePosted && forced == 0 && merger.buffered() == 0 && drops == 0;
+        }
+
+        // A slow link with one early sample holds the watermark back while a fast link
+        // with a small window and queue keeps delivering in short bursts
+        bool fullWindowElsewhere() {
+            const std::size_t Window = 16;
+            const std::size_t Bursts = 40;
+            const std::size_t BurstSize = 32;
+
+            DataProvider slow;
+            DataProvider fast(64);
+            DataProvider output(Bursts * BurstSize + 2);
+            Collector collector;
+            output.attach(&collector);
+            TimestampMerger merger;
+            const std::size_t slowSource = merger.addSource(slow, 10 * Second);
+            const std::size_t fastSource = merger.addSource(fast, 10 * Millisecond, Window);
+
+            slow.post(Sample::fromInt(0, 0, 0)); // the oldest head, in a window far from full
+            std::int64_t timestamp = Millisecond;
+            for (std::size_t burst = 0; burst < Bursts; ++burst) {
+                for (std::size_t i = 0; i < BurstSize; ++i, timestamp += Millisecond) {
+                    fast.post(Sample::fromInt(1, timestamp, static_cast<std::int64_t>(burst)));
+                }
+                merger.pump(output, 0);
+            }
+            // Older than everything the fast link forced out
+            slow.post(Sample::fromInt(0, Millisecond, 1));
+            merger.pump(output, 0);
+            merger.pump(output, TimestampMerger::DefaultIdleTimeout + 1);
+            output.drain();
+
+            const bool ordered = inOrder(collector.samples);
+            const TimestampMerger::SourceStats& slowStats = merger.stats(slowSource);
+            const TimestampMerger::SourceStats& fastStats = merger.stats(fastSource);
+            std::printf("full window elsewhere: %zu samples out, in order: %s; forced %llu slow + %llu fast, "
+                "late %llu, fast queue dropped %llu\n", collector.samples.size(), ordered ? "yes" : "no",
+                static_cast<unsigned long long>(slowStats.forced), static_cast<unsigned long long>(fastStats.forced),
+                static_cast<unsigned long long>(slowStats.late),
+                static_cast<unsigned long long>(fast.ingestQueue().dropCount()));
+            return ordered && fast.ingestQueue().dropCount() == 0 && collector.samples.size() == Bursts * BurstSize + 1 &&
+                slowStats.forced == 1 && fastStats.forced > 0 && slowStats.late == 1 && fastStats.late == 0;
+        }
+
+    } // namespace
+
+    bool benchTimestampMerger() {
+        const bool jittered = jitteredSources();
+        const bool elsewhere = fullWindowElsewhere();
+        return jittered && elsewhere;
+    }
+
+} // namespace SkyLine
@@ -1,11 +1,14 @@
 #ifndef SKYLINE_OBSERVER_H
 #define SKYLINE_OBSERVER_H
 
+#include "Sample.h"
+
 namespace SkyLink {
 
     class Observer {
     public:
-        virtual void onDataUpdated(int newData) = 0;
+        // Called once per tick with every sample delivered in that tick
+        virtual void onSamples(SampleSpan samples) = 0;
         virtual ~Observer() = default;
     };
 
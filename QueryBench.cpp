@@ -0,0 +1,189 @@
+// Archive aggregates on the thread pool: two flights are archived with 1 s
+// chunks and queried with pools of one and four threads. Count, min, max,
+// sum, time above threshold (held across chunk boundaries and empty spans)
+// and the histogram must equal a brute-force pass over the samples, for
+// windows that cover whole chunks, start or end inside one, or hold nothing.
+// A task that throws must surface on the caller as that exception, once the
+// other tasks are done, and leave the pool usable.
+#include "ArchiveQuery.h"
+#include "ArchiveWriter.h"
+#include "Bench.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const FlightPaths[] = { "skylinkbench-query-1.skyarc", "skylinkbench-query-2.skyarc" };
+        const std::int64_t Millisecond = 1000ll * 1000;
+        const std::int64_t Second = 1000 * Millisecond;
+
+        // Values are multiples of 1/4, so sums are exact in any order
+        std::vector<Sample> flight(int number) {
+            std::vector<Sample> samples;
+            const std::int64_t start = number == 0 ? 0 : 100 * Second;
+            const std::int64_t duration = number == 0 ? 20 * Second : 10 * Second;
+            const std::int64_t step = number == 0 ? 10 * Millisecond : 20 * Millisecond;
+            std::int64_t i = 0;
+            for (std::int64_t t = start; t < start + duration; t += step, ++i) {
+                // 0: dense doubles, 1: one sample every 2.5 s so most spans are empty, 2: ints
+                samples.push_back(Sample::fromDouble(0, t, static_cast<double>((i * 13) % 97 - 48) / 4.0));
+                if (i % (2500 * Millisecond / step) == 0) {
+                    samples.push_back(Sample::fromDouble(1, t, static_cast<double>(i % 40) / 4.0));
+                }
+                samples.push_back(Sample::fromInt(2, t, i % 21 - 10));
+            }
+            return samples;
+        }
+
+        AggregateResult bruteForce(const std::vector<std::vector<Sample>>& flights, const AggregateRequest& request) {
+            AggregateResult result;
+            result.histogram.assign(request.histogramBins, 0);
+            const bool wantHistogram = request.histogramBins > 0 && request.histogramMax > request.histogramMin;
+            const double scale = wantHistogram ? request.histogramBins / (request.histogramMax - request.histogramMin) : 0.0;
+            for (const std::vector<Sample>& samples : flights) {
+                const Sample* previous = nullptr; // held value, within this flight only
+                for (const Sample& sample : samples) {
+                    if (sample.channel != request.channel || sample.timestamp < request.from || sample.timestamp > request.to) {
+                        continue;
+                    }
+                    const double value = sample.asDouble();
+                    ++result.count;
+                    result.min = std::min(result.min, value);
+                    result.max = std::max(result.max, value);
+                    result.sum += value;
+                    if (previous && previous->asDouble() > request.threshold) {
+                        result.timeAbove += sample.timestamp - previous->timestamp;
+                    }
+                    previous = &sample;
+                    const double position = (value - request.histogramMin) * scale;
+                    if (wantHistogram && position >= 0.0 && position < request.histogramBins) {
+                        ++result.histogram[static_cast<std::size_t>(position)];
+                    }
+                }
+            }
+            return result;
+        }
+
+        bool sameResult(const AggregateResult& a, const AggregateResult& b) {
+            return a.count == b.count && a.min == b.min && a.max == b.max && a.sum == b.sum &&
+                a.timeAbove == b.timeAbove && a.histogram == b.histogram;
+        }
+
+        std::vector<AggregateRequest> requests() {
+            std::vector<AggregateRequest> list;
+            const std::pair<std::int64_t, std::int64_t> windows[] = {
+                { -Second, 200 * Second },                           // everything, whole chunks only
+                { 3 * Second, 7 * Second - 1 },                      // span aligned
+                { 2 * Second + 333 * Millisecond, 9 * Second + 5 * Millisecond }, // edges inside chunks
+                { 4 * Second + 1, 4 * Second + 9 * Millisecond },    // inside one chunk, between samples
+                { 5 * Second, 5 * Second },                          // a single instant
+                { 30 * Second, 90 * Second },                        // between the flights
+                { 15 * Second, 105 * Second + 500 * Millisecond }    // end of one flight, start of the other
+            };
+            for (const std::pair<std::int64_t, std::int64_t>& window : windows) {
+                for (ChannelId channel = 0; channel < 4; ++channel) { // 3 was never recorded
+                    AggregateRequest plain;
+                    plain.channel = channel;
+                    plain.from = window.first;
+                    plain.to = window.second;
+                    list.push_back(plain);
+
+                    AggregateRequest full = plain;
+                    full.threshold = 5.0; // reached exactly, which does not count as above
+                    full.histogramBins = 8;
+                    full.histogramMin = -10.0;
+                    full.histogramMax = 10.0;
+                    list.push_back(full);
+                }
+            }
+            return list;
+        }
+
+        // A task that throws partway through a job, on a pool of the given size
+        bool exceptionSurfaces(unsigned threads) {
+            ThreadPool pool(threads);
+            std::atomic<std::size_t> ran(0);
+            bool caught = false;
+            try {
+                pool.parallelFor(10000, [&ran](std::size_t index, unsigned) {
+                    if (index == 100) {
+                        throw std::runtime_error("task 100");
+                    }
+                    ran.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            catch (const std::runtime_error& error) {
+                caught = std::string(error.what()) == "task 100";
+            }
+            // The job stopped handing out indices, and the pool takes the next one as usual
+            std::atomic<std::size_t> after(0);
+            pool.parallelFor(1000, [&after](std::size_t, unsigned) { after.fetch_add(1, std::memory_order_relaxed); });
+            return caught && ran.load() < 9999 && after.load() == 1000;
+        }
+
+    } // namespace
+
+    bool benchArchiveQuery() {
+        std::vector<std::vector<Sample>> flights;
+        ArchiveReader readers[2];
+        bool written = true;
+        for (int number = 0; number < 2; ++number) {
+            flights.push_back(flight(number));
+            ArchiveWriter writer;
+            written = written && writer.open(FlightPaths[number], Second);
+            writer.append(SampleSpan(flights.back().data(), flights.back().size()));
+            written = written && writer.close() && readers[number].open(FlightPaths[number]);
+        }
+        if (!written) {
+            MappedFile::remove(FlightPaths[0]);
+            MappedFile::remove(FlightPaths[1]);
+            return false;
+        }
+
+        const std::vector<AggregateRequest> list = requests();
+        std::vector<AggregateResult> expected;
+        for (const AggregateRequest& request : list) {
+            expected.push_back(bruteForce(flights, request));
+        }
+
+        bool same = true;
+        const unsigned poolSizes[] = { 1, 4 };
+        for (unsigned threads : poolSizes) {
+            ThreadPool pool(threads);
+            ArchiveQuery query(pool);
+            query.addArchive(&readers[0]);
+            query.addArchive(&readers[1]);
+            const auto start = std::chrono::steady_clock::now();
+            const std::vector<AggregateResult> results = query.run(list);
+            const double seconds = secondsSince(start);
+            std::size_t wrong = 0;
+            for (std::size_t i = 0; i < list.size(); ++i) {
+                wrong += sameResult(results[i], expected[i]) ? 0 : 1;
+            }
+            std::printf("%u thread%s: %zu requests in %.2f ms, %zu differ from brute force\n", threads,
+                threads == 1 ? "" : "s", list.size(), seconds * 1e3, wrong);
+            same = same && results.size() == list.size() && wrong == 0;
+        }
+        for (ArchiveReader& reader : readers) {
+            reader.close();
+        }
+        MappedFile::remove(FlightPaths[0]);
+        MappedFile::remove(FlightPaths[1]);
+
+        const bool thrownAlone = exceptionSurfaces(1);
+        const bool thrownShared = exceptionSurfaces(4);
+        std::printf("task exception rethrown on the caller, pool reusable: 1 thread %s, 4 threads %s\n",
+            thrownAlone ? "yes" : "no", thrownShared ? "yes" : "no");
+        return same && thrownAlone && thrownShared;
+    }
+
+} // namespace SkyLine
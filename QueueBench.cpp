@@ -0,0 +1,152 @@
+// Queued subscribers, one per backpressure policy. With the worker not yet
+// running, an overfull publish must drop exactly the surplus: the newest
+// for DropNewest, the oldest for DropOldest, every overwritten value and
+// every channel past the channel count for LatestOnly, and then deliver
+// what was kept. The publishing side must not allocate. Behind a slow
+// subscriber, Block must make the publisher wait and lose nothing.
+#include "Bench.h"
+#include "QueuedObserver.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::size_t Capacity = 100;
+        const std::size_t Published = 250;
+        const ChannelId LatestChannels = 8;
+
+        class Recorder : public Observer {
+        public:
+            explicit Recorder(int delayMs = 0) : delayMs(delayMs) {}
+
+            std::vector<Sample> samples; // worker thread only until stop() joined it
+
+            void onSamples(SampleSpan batch) override {
+                samples.insert(samples.end(), batch.begin(), batch.end());
+                if (delayMs > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+                }
+            }
+
+        private:
+            int delayMs;
+        };
+
+        struct Outcome {
+            std::uint64_t drops;
+            std::uint64_t allocations; // on the publishing side
+            std::vector<Sample> delivered;
+        };
+
+        Outcome publishThenDeliver(BackpressurePolicy policy, std::size_t capacity, const std::vector<Sample>& samples) {
+            Recorder recorder;
+            QueuedObserver queue(recorder, policy, capacity);
+            const std::uint64_t before = allocationCount();
+            queue.onSamples(SampleSpan(samples.data(), samples.size()));
+            const std::uint64_t allocations = allocationCount() - before;
+            queue.start();
+            queue.stop();
+            return Outcome{ queue.dropCount(), allocations, recorder.samples };
+        }
+
+        // Delivered values, in order, are exactly first..last
+        bool delivers(const std::vector<Sample>& delivered, std::int64_t first, std::int64_t last) {
+            if (delivered.size() != static_cast<std::size_t>(last - first + 1)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < delivered.size(); ++i) {
+                if (delivered[i].intValue != first + static_cast<std::int64_t>(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::vector<Sample> sequence(std::size_t count) {
+            std::vector<Sample> samples;
+            for (std::size_t i = 0; i < count; ++i) {
+                samples.push_back(Sample::fromInt(0, static_cast<std::int64_t>(i), static_cast<std::int64_t>(i)));
+            }
+            return samples;
+        }
+
+        // Three rounds over channels 0..9, with only 0..7 inside the channel count
+        bool latestOnly() {
+            std::vector<Sample> samples;
+            for (std::int64_t round = 0; round < 3; ++round) {
+                for (ChannelId channel = 0; channel < LatestChannels + 2; ++channel) {
+                    samples.push_back(Sample::fromInt(channel, round, round * 100 + channel));
+                }
+            }
+            const Outcome outcome = publishThenDeliver(BackpressurePolicy::LatestOnly, LatestChannels, samples);
+            const std::uint64_t expectedDrops = 3 * 2 + 2 * LatestChannels; // out of range, then overwritten
+            bool newest = outcome.delivered.size() == LatestChannels;
+            std::vector<bool> seen(LatestChannels, false);
+            for (const Sample& sample : outcome.delivered) {
+                newest = newest && sample.channel < LatestChannels && !seen[sample.channel] &&
+                    sample.intValue == 200 + sample.channel;
+                if (sample.channel < LatestChannels) {
+                    seen[sample.channel] = true;
+                }
+            }
+            std::printf("LatestOnly: %zu samples on %u channels, dropped %llu (expected %llu), delivered %zu, newest only: %s, "
+                "publish allocations %llu\n", samples.size(), LatestChannels + 2,
+                static_cast<unsigned long long>(outcome.drops), static_cast<unsigned long long>(expectedDrops),
+                outcome.delivered.size(), newest ? "yes" : "no", static_cast<unsigned long long>(outcome.allocations));
+            return outcome.drops == expectedDrops && newest && outcome.allocations == 0;
+        }
+
+        // A subscriber far slower than the publisher: every push past the capacity has to wait
+        bool blockLosesNothing() {
+            const std::size_t Batches = 20;
+            const std::size_t BatchSamples = 500;
+            Recorder recorder(1);
+            QueuedObserver queue(recorder, BackpressurePolicy::Block, Capacity);
+            queue.start();
+            const std::vector<Sample> all = sequence(Batches * BatchSamples);
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < Batches; ++i) {
+                queue.onSamples(SampleSpan(all.data() + i * BatchSamples, BatchSamples));
+            }
+            const double seconds = secondsSince(start);
+            queue.stop();
+            const bool intact = delivers(recorder.samples, 0, static_cast<std::int64_t>(all.size()) - 1);
+            std::printf("Block: %zu samples through a %zu-sample queue, dropped %llu, delivered in order: %s, "
+                "high water %zu, publisher waited %.1f ms\n", all.size(), Capacity,
+                static_cast<unsigned long long>(queue.dropCount()), intact ? "yes" : "no", queue.highWaterMark(),
+                seconds * 1e3);
+            return queue.dropCount() == 0 && intact && queue.deliveredCount() == all.size() &&
+                queue.highWaterMark() <= Capacity;
+        }
+
+    } // namespace
+
+    bool benchQueuedObserver() {
+        const std::vector<Sample> samples = sequence(Published);
+        const std::int64_t last = static_cast<std::int64_t>(Published) - 1;
+        const std::int64_t surplus = static_cast<std::int64_t>(Published - Capacity);
+
+        const Outcome newest = publishThenDeliver(BackpressurePolicy::DropNewest, Capacity, samples);
+        const bool keptFirst = newest.drops == Published - Capacity && newest.allocations == 0 &&
+            delivers(newest.delivered, 0, static_cast<std::int64_t>(Capacity) - 1);
+        std::printf("DropNewest: %zu into %zu, dropped %llu, kept the first: %s, publish allocations %llu\n",
+            Published, Capacity, static_cast<unsigned long long>(newest.drops), keptFirst ? "yes" : "no",
+            static_cast<unsigned long long>(newest.allocations));
+
+        const Outcome oldest = publishThenDeliver(BackpressurePolicy::DropOldest, Capacity, samples);
+        const bool keptLast = oldest.drops == Published - Capacity && oldest.allocations == 0 &&
+            delivers(oldest.delivered, surplus, last);
+        std::printf("DropOldest: %zu into %zu, dropped %llu, kept the last: %s, publish allocations %llu\n",
+            Published, Capacity, static_cast<unsigned long long>(oldest.drops), keptLast ? "yes" : "no",
+            static_cast<unsigned long long>(oldest.allocations));
+
+        const bool latest = latestOnly();
+        const bool blocked = blockLosesNothing();
+        return keptFirst && keptLast && latest && blocked;
+    }
+
+} // namespace SkyLine
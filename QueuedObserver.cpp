@@ -0,0 +1,164 @@
+#include "QueuedObserver.h"
+
+namespace SkyLink {
+
+    QueuedObserver::QueuedObserver(Observer& target, BackpressurePolicy policy, std::size_t capacity)
+        : subscriber(target), mode(policy), running(false), head(0), count(0),
+        depth(0), highWater(0), delivered(0), drops(0) {
+        if (capacity < 1) {
+            capacity = 1;
+        }
+        if (mode == BackpressurePolicy::LatestOnly) {
+            latest.resize(capacity);
+            isFresh.resize(capacity, 0);
+            fresh.reserve(capacity); // a channel is listed at most once
+        }
+        else {
+            ring.resize(capacity);
+        }
+        batch.resize(BatchSize);
+    }
+
+    QueuedObserver::~QueuedObserver() {
+        stop();
+    }
+
+    void QueuedObserver::start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) {
+            return;
+        }
+        running = true;
+        worker = std::thread(&QueuedObserver::run, this);
+    }
+
+    void QueuedObserver::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        ready.notify_one();
+        space.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void QueuedObserver::publishDepth() {
+        const std::size_t queuedNow = mode == BackpressurePolicy::LatestOnly ? fresh.size() : count;
+        depth.store(queuedNow, std::memory_order_relaxed);
+        if (queuedNow > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(queuedNow, std::memory_order_relaxed);
+        }
+    }
+
+    void QueuedObserver::onSamples(SampleSpan samples) {
+        if (samples.empty()) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (mode == BackpressurePolicy::LatestOnly) {
+                for (const Sample& sample : samples) {
+                    keepLatest(sample);
+                }
+            }
+            else {
+                for (const Sample& sample : samples) {
+                    enqueue(sample, lock);
+                }
+            }
+            publishDepth();
+        }
+        ready.notify_one();
+    }
+
+    void QueuedObserver::enqueue(const Sample& sample, std::unique_lock<std::mutex>& lock) {
+        const std::size_t size = ring.size();
+        if (count == size) {
+            switch (mode) {
+            case BackpressurePolicy::Block:
+                // Without a worker nobody would ever make room
+                if (running) {
+                    ready.notify_one();
+                    space.wait(lock, [this, size] { return count < size || !running; });
+                }
+                if (count == size) {
+                    drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return;
+                }
+                break;
+            case BackpressurePolicy::DropOldest:
+                head = head + 1 == size ? 0 : head + 1;
+                --count;
+                drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                break;
+            default:
+                drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        std::size_t tail = head + count;
+        if (tail >= size) {
+            tail -= size;
+        }
+        ring[tail] = sample;
+        ++count;
+    }
+
+    void QueuedObserver::keepLatest(const Sample& sample) {
+        const ChannelId channel = sample.channel;
+        if (channel >= latest.size()) {
+            // Growing here would allocate under the lock, on the publishing thread
+            drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        latest[channel] = sample;
+        if (isFresh[channel]) {
+            drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // overwritten before delivery
+            return;
+        }
+        isFresh[channel] = 1;
+        fresh.push_back(channel);
+    }
+
+    std::size_t QueuedObserver::takeBatch() {
+        std::size_t taken = 0;
+        if (mode == BackpressurePolicy::LatestOnly) {
+            const std::size_t start = fresh.size() > BatchSize ? fresh.size() - BatchSize : 0;
+            for (std::size_t i = start; i < fresh.size(); ++i) {
+                batch[taken++] = latest[fresh[i]];
+                isFresh[fresh[i]] = 0;
+            }
+            fresh.resize(start);
+        }
+        else {
+            const std::size_t size = ring.size();
+            while (taken < BatchSize && count > 0) {
+                batch[taken++] = ring[head];
+                head = head + 1 == size ? 0 : head + 1;
+                --count;
+            }
+        }
+        publishDepth();
+        return taken;
+    }
+
+    void QueuedObserver::run() {
+        for (;;) {
+            std::size_t taken;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return pending() || !running; });
+                if (!pending()) {
+                    return; // stopped and drained
+                }
+                taken = takeBatch();
+            }
+            space.notify_one();
+            subscriber.onSamples(SampleSpan(batch.data(), taken));
+            delivered.store(delivered.load(std::memory_order_relaxed) + taken, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace SkyLine
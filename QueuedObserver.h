@@ -0,0 +1,92 @@
+#ifndef SKYLINE_QUEUEDOBSERVER_H
+#define SKYLINE_QUEUEDOBSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Observer.h"
+
+namespace SkyLink {
+
+    // What a subscriber's queue does when the subscriber falls behind
+    enum class BackpressurePolicy {
+        Block,      // publisher waits for room, nothing is lost
+        DropOldest, // oldest queued samples make room for new ones
+        DropNewest, // new samples are discarded while the queue is full
+        LatestOnly  // only the newest value per channel is kept
+    };
+
+    // Runs a slow subscriber on its own thread behind a bounded queue, so the
+    // publishing loop only pays for a copy into the queue. The lock is held
+    // for that copy and for the worker taking a batch out, never while the
+    // subscriber itself runs. Nothing is allocated after construction.
+    class QueuedObserver : public Observer {
+    public:
+        static const std::size_t DefaultCapacity = 16384;
+        static const std::size_t BatchSize = 1024; // samples handed to the subscriber per call
+
+        // capacity: queued samples, or for LatestOnly the channel count; samples on
+        // channels at or above it are dropped and counted
+        QueuedObserver(Observer& target, BackpressurePolicy policy, std::size_t capacity = DefaultCapacity);
+        ~QueuedObserver();
+
+        QueuedObserver(const QueuedObserver&) = delete;
+        QueuedObserver& operator=(const QueuedObserver&) = delete;
+
+        // Publishing thread; the subscriber is only ever called from the worker
+        void onSamples(SampleSpan samples) override;
+
+        void start();
+        void stop(); // delivers what is still queued, then joins the worker
+
+        Observer& target() const { return subscriber; }
+        BackpressurePolicy policy() const { return mode; }
+        std::size_t capacity() const { return mode == BackpressurePolicy::LatestOnly ? latest.size() : ring.size(); }
+        std::size_t queued() const { return depth.load(std::memory_order_relaxed); }
+        std::size_t highWaterMark() const { return highWater.load(std::memory_order_relaxed); }
+        std::uint64_t deliveredCount() const { return delivered.load(std::memory_order_relaxed); }
+        std::uint64_t dropCount() const { return drops.load(std::memory_order_relaxed); }
+
+    private:
+        void run();
+        bool pending() const { return count > 0 || !fresh.empty(); }
+        void enqueue(const Sample& sample, std::unique_lock<std::mutex>& lock);
+        void keepLatest(const Sample& sample);
+        std::size_t takeBatch();
+        void publishDepth();
+
+        Observer& subscriber;
+        const BackpressurePolicy mode;
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::condition_variable space;
+        bool running;
+        std::thread worker;
+
+        // Ring of queued samples (Block, DropOldest, DropNewest)
+        std::vector<Sample> ring;
+        std::size_t head;
+        std::size_t count;
+
+        // Newest value per channel plus the channels changed since the last batch (LatestOnly),
+        // all sized to the channel count up front
+        std::vector<Sample> latest;
+        std::vector<std::uint8_t> isFresh;
+        std::vector<ChannelId> fresh;
+
+        std::vector<Sample> batch; // worker only
+
+        std::atomic<std::size_t> depth;
+        std::atomic<std::size_t> highWater;
+        std::atomic<std::uint64_t> delivered;
+        std::atomic<std::uint64_t> drops;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_QUEUEDOBSERVER_H
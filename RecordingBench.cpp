@@ -0,0 +1,121 @@
+// Recorder sessions: two recorders opened on the same base keep separate
+// sessions, the reader does not merge a segment from another session, and
+// a raw block whose header claims more samples than its payload holds is
+// rejected at open() instead of being read past its end. A channel id above
+// the Gorilla cap is recorded as a raw block and reads back intact.
+#include "Bench.h"
+#include "FlightRecorder.h"
+#include "GorillaCodec.h"
+#include "RecordingReader.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const BasePath = "skylinkbench-flight";
+        const std::size_t SegmentBytes = 64 * 1024;
+        const std::size_t BatchSamples = 100;
+
+        std::uint64_t record(FlightRecorder& recorder, std::size_t batches) {
+            Sample batch[BatchSamples];
+            std::uint64_t timestamp = 0;
+            for (std::size_t i = 0; i < batches; ++i) {
+                for (Sample& sample : batch) {
+                    sample = Sample::fromDouble(static_cast<ChannelId>(timestamp % 8), static_cast<std::int64_t>(timestamp),
+                        static_cast<double>(timestamp) * 0.5);
+                    ++timestamp;
+                }
+                recorder.append(SampleSpan(batch, BatchSamples));
+            }
+            return timestamp;
+        }
+
+        void copyFile(const std::string& from, const std::string& to) {
+            std::ifstream in(from, std::ios::binary);
+            std::ofstream out(to, std::ios::binary | std::ios::trunc);
+            out << in.rdbuf();
+        }
+
+        void removeSession(const std::string& session) {
+            for (std::uint32_t index = 0; MappedFile::exists(recordingSegmentPath(session, index)); ++index) {
+                MappedFile::remove(recordingSegmentPath(session, index));
+            }
+        }
+
+    } // namespace
+
+    bool benchRecording() {
+        FlightRecorder first;
+        if (!first.open(BasePath, SegmentBytes)) {
+            return false;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t firstSamples = record(first, 200);
+        const double seconds = secondsSince(start);
+        const std::string firstSession = first.sessionPath();
+        const std::uint32_t firstSegments = first.segmentCount();
+        first.close();
+
+        // A restart on the same base path
+        FlightRecorder second;
+        if (!second.open(BasePath, SegmentBytes)) {
+            removeSession(firstSession);
+            return false;
+        }
+        const std::uint64_t secondSamples = record(second, 10);
+        const std::string secondSession = second.sessionPath();
+        second.close();
+
+        // A stray segment of the first session where the second one would continue
+        copyFile(recordingSegmentPath(firstSession, 1), recordingSegmentPath(secondSession, 1));
+
+        RecordingReader reader;
+        const bool firstIntact = reader.open(firstSession) && reader.sampleCount() == firstSamples;
+        const bool secondAlone = reader.open(secondSession) && reader.sampleCount() == secondSamples;
+
+        // Corrupt the sample count of the second session's first block; its payload CRC still matches
+        {
+            std::fstream file(recordingSegmentPath(secondSession, 0), std::ios::binary | std::ios::in | std::ios::out);
+            const std::uint32_t claimed = 1000000;
+            file.seekp(sizeof(RecordingHeader) + 8);
+            file.write(reinterpret_cast<const char*>(&claimed), sizeof(claimed));
+        }
+        const bool corruptRejected = reader.open(secondSession) &&
+            reader.sampleCount() == secondSamples - BatchSamples && reader.corruptBlocks() == 1;
+
+        // One sample the Gorilla codec refuses, in a session of its own
+        FlightRecorder wide;
+        wide.setEncoding(BlockEncoding::GorillaSamples);
+        bool wideReadBack = false;
+        std::string wideSession;
+        if (wide.open(BasePath, SegmentBytes)) {
+            const Sample sample = Sample::fromInt(GorillaEncoder::MaxChannel + 7, 1, 42);
+            wide.append(SampleSpan(&sample, 1));
+            wideSession = wide.sessionPath();
+            wide.close();
+            std::vector<Sample> scratch;
+            wideReadBack = reader.open(wideSession) && reader.sampleCount() == 1 &&
+                reader.blockSamples(0, scratch)[0].channel == GorillaEncoder::MaxChannel + 7 &&
+                reader.blockSamples(0, scratch)[0].intValue == 42;
+        }
+        reader.close();
+
+        std::printf("%llu samples in %u segments at %.1f M samples/s, sessions %s and %s\n",
+            static_cast<unsigned long long>(firstSamples), firstSegments, firstSamples / seconds / 1e6,
+            firstSession.c_str(), secondSession.c_str());
+        std::printf("first session intact: %s, stray segment ignored: %s, corrupt count rejected: %s, wide channel raw: %s\n",
+            firstIntact ? "yes" : "no", secondAlone ? "yes" : "no", corruptRejected ? "yes" : "no", wideReadBack ? "yes" : "no");
+
+        removeSession(firstSession);
+        removeSession(secondSession);
+        if (!wideSession.empty()) {
+            removeSession(wideSession);
+        }
+        return firstSegments > 2 && firstIntact && secondAlone && corruptRejected && wideReadBack && firstSession != secondSession;
+    }
+
+} // namespace SkyLine
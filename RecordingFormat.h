@@ -0,0 +1,88 @@
+#ifndef SKYLINE_RECORDINGFORMAT_H
+#define SKYLINE_RECORDINGFORMAT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    // On-disk layout of a flight recorder segment (little-endian):
+    //
+    //   RecordingHeader | BlockHeader payload | BlockHeader payload | ... | unused
+    //
+    // The writer publishes a block by advancing RecordingHeader::tail after
+    // the block is complete, so a reader never sees a partial block.
+
+    const char RecordingMagic[8] = { 'S', 'K', 'Y', 'L', 'R', 'E', 'C', '1' };
+    // 2: compressed blocks, payloads padded to 8 bytes; 3: session id in every segment
+    const std::uint32_t RecordingVersion = 3;
+    const std::uint32_t BlockMagic = 0x42594B53; // "SKYB"
+
+    enum class BlockEncoding : std::uint16_t {
+        RawSamples = 0,    // payload is sampleCount packed Sample structs
+        GorillaSamples = 1 // GorillaCodec bit stream, see GorillaCodec.h
+    };
+
+    struct RecordingHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t capacity;      // segment size in bytes
+        std::int64_t createdAt;      // nanoseconds
+        std::uint32_t segmentIndex;
+        std::uint32_t reserved0;
+        std::uint64_t tail;          // end of the last complete block, atomic
+        std::uint64_t blockCount;    // atomic
+        std::uint64_t sessionId;     // same in every segment of a recording, 0 before version 3
+    };
+
+    struct BlockHeader {
+        std::uint32_t magic;
+        std::uint16_t encoding;
+        std::uint16_t reserved;
+        std::uint32_t sampleCount;
+        std::uint32_t payloadBytes;  // including padding
+        std::int64_t firstTimestamp;
+        std::int64_t lastTimestamp;
+        std::uint32_t crc;           // CRC-32 of the payload
+        std::uint32_t padding;
+    };
+
+    static_assert(sizeof(RecordingHeader) == 64, "RecordingHeader layout changed");
+    static_assert(sizeof(BlockHeader) == 40, "BlockHeader layout changed");
+    static_assert(sizeof(Sample) == 24, "Sample layout changed");
+    static_assert(std::is_trivially_copyable<Sample>::value, "Sample must be memcpy-able");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "tail must be lock-free");
+
+    inline std::atomic<std::uint64_t>& headerTail(RecordingHeader& header) {
+        return *reinterpret_cast<std::atomic<std::uint64_t>*>(&header.tail);
+    }
+
+    inline const std::atomic<std::uint64_t>& headerTail(const RecordingHeader& header) {
+        return *reinterpret_cast<const std::atomic<std::uint64_t>*>(&header.tail);
+    }
+
+    inline std::atomic<std::uint64_t>& headerBlockCount(RecordingHeader& header) {
+        return *reinterpret_cast<std::atomic<std::uint64_t>*>(&header.blockCount);
+    }
+
+    inline bool isRecordingHeader(const RecordingHeader& header) {
+        return std::memcmp(header.magic, RecordingMagic, sizeof(RecordingMagic)) == 0 &&
+            header.version >= 1 && header.version <= RecordingVersion;
+    }
+
+    // "<base>.0003.skyrec"
+    inline std::string recordingSegmentPath(const std::string& basePath, std::uint32_t index) {
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), ".%04u.skyrec", index);
+        return basePath + suffix;
+    }
+
+} // namespace SkyLine
+
+#endif // SKYLINE_RECORDINGFORMAT_H
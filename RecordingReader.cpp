@@ -0,0 +1,166 @@
+#include "RecordingReader.h"
+#include "Crc32.h"
+#include "GorillaCodec.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace SkyLink {
+
+    bool RecordingReader::open(const std::string& basePath) {
+        close();
+        for (std::uint32_t segment = 0;; ++segment) {
+            const std::string path = recordingSegmentPath(basePath, segment);
+            if (!std::ifstream(path, std::ios::binary).good()) {
+                break;
+            }
+            std::unique_ptr<MappedFile> file(new MappedFile());
+            if (!file->openReadOnly(path)) {
+                break;
+            }
+            if (!belongsToSession(*file, segment)) {
+                std::cerr << "ERROR::RECORDINGREADER::" << path << " is from another session, ignored" << std::endl;
+                break;
+            }
+            segments.push_back(std::move(file));
+            indexSegment(segment);
+        }
+        if (segments.empty()) {
+            std::cerr << "ERROR::RECORDINGREADER::No segments found for " << basePath << std::endl;
+            return false;
+        }
+
+        // Segments are written in order, but keep the index sorted for binary search anyway
+        std::stable_sort(index.begin(), index.end(), [](const BlockRef& a, const BlockRef& b) {
+            return a.firstTimestamp < b.firstTimestamp;
+            });
+        return true;
+    }
+
+    void RecordingReader::close() {
+        segments.clear();
+        index.clear();
+        sessionId = 0;
+        totalSamples = 0;
+        badBlocks = 0;
+    }
+
+    bool RecordingReader::belongsToSession(const MappedFile& file, std::uint32_t segment) const {
+        if (file.size() < sizeof(RecordingHeader)) {
+            return segment == 0; // reported as a bad header by indexSegment()
+        }
+        const RecordingHeader& header = *reinterpret_cast<const RecordingHeader*>(file.data());
+        if (segment == 0) {
+            return true;
+        }
+        if (!isRecordingHeader(header) || header.segmentIndex != segment) {
+            return false;
+        }
+        // Version 1 and 2 segments carry no session id
+        return header.version < 3 || header.sessionId == sessionId;
+    }
+
+    void RecordingReader::indexSegment(std::uint32_t segment) {
+        const MappedFile& file = *segments[segment];
+        if (file.size() < sizeof(RecordingHeader)) {
+            return;
+        }
+        const RecordingHeader& header = *reinterpret_cast<const RecordingHeader*>(file.data());
+        if (!isRecordingHeader(header)) {
+            std::cerr << "ERROR::RECORDINGREADER::Bad header in " << file.path() << std::endl;
+            return;
+        }
+        if (segment == 0 && header.version >= 3) {
+            sessionId = header.sessionId;
+        }
+
+        std::uint64_t tail = headerTail(header).load(std::memory_order_acquire);
+        if (tail > file.size()) {
+            tail = file.size();
+        }
+
+        std::uint64_t offset = header.headerSize;
+        while (offset + sizeof(BlockHeader) <= tail) {
+            BlockHeader blockHeader;
+            std::memcpy(&blockHeader, file.data() + offset, sizeof(BlockHeader));
+            if (blockHeader.magic != BlockMagic ||
+                offset + sizeof(BlockHeader) + blockHeader.payloadBytes > tail) {
+                ++badBlocks;
+                break; // cannot find the next block boundary
+            }
+            const std::uint8_t* payload = file.data() + offset + sizeof(BlockHeader);
+            // The CRC covers only the payload, so the header's sampleCount is checked against the payload
+            // size: blockSamples() trusts it when it hands out or copies the samples
+            bool sizeMatches = false;
+            if (blockHeader.encoding == static_cast<std::uint16_t>(BlockEncoding::RawSamples)) {
+                sizeMatches = static_cast<std::uint64_t>(blockHeader.sampleCount) * sizeof(Sample) == blockHeader.payloadBytes;
+            }
+            else if (blockHeader.encoding == static_cast<std::uint16_t>(BlockEncoding::GorillaSamples)) {
+                sizeMatches = static_cast<std::uint64_t>(blockHeader.sampleCount) <= static_cast<std::uint64_t>(blockHeader.payloadBytes) * 8;
+            }
+            if (sizeMatches && blockHeader.sampleCount > 0 && crc32(payload, blockHeader.payloadBytes) == blockHeader.crc) {
+                BlockRef ref;
+                ref.segment = segment;
+                ref.offset = offset;
+                ref.firstTimestamp = blockHeader.firstTimestamp;
+                ref.lastTimestamp = blockHeader.lastTimestamp;
+                ref.sampleCount = blockHeader.sampleCount;
+                index.push_back(ref);
+                totalSamples += blockHeader.sampleCount;
+            }
+            else {
+                ++badBlocks;
+            }
+            offset += sizeof(BlockHeader) + blockHeader.payloadBytes;
+        }
+    }
+
+    std::int64_t RecordingReader::startTime() const {
+        return index.empty() ? 0 : index.front().firstTimestamp;
+    }
+
+    std::int64_t RecordingReader::endTime() const {
+        std::int64_t end = 0;
+        for (const BlockRef& ref : index) {
+            end = std::max(end, ref.lastTimestamp);
+        }
+        return end;
+    }
+
+    std::size_t RecordingReader::findBlock(std::int64_t timestamp) const {
+        auto it = std::upper_bound(index.begin(), index.end(), timestamp,
+            [](std::int64_t value, const BlockRef& ref) { return value < ref.firstTimestamp; });
+        if (it == index.begin()) {
+            return 0;
+        }
+        return static_cast<std::size_t>(it - index.begin()) - 1;
+    }
+
+    SampleSpan RecordingReader::blockSamples(std::size_t i, std::vector<Sample>& scratch) const {
+        const BlockRef& ref = index[i];
+        const std::uint8_t* block = segments[ref.segment]->data() + ref.offset;
+        BlockHeader blockHeader;
+        std::memcpy(&blockHeader, block, sizeof(BlockHeader));
+
+        const std::uint8_t* payload = block + sizeof(BlockHeader);
+        if (blockHeader.encoding == static_cast<std::uint16_t>(BlockEncoding::GorillaSamples)) {
+            // Decoder state is per call so blocks can be decoded from several threads
+            GorillaDecoder decoder;
+            scratch.resize(blockHeader.sampleCount);
+            if (!decoder.decode(payload, blockHeader.payloadBytes, blockHeader.firstTimestamp,
+                blockHeader.sampleCount, scratch.data())) {
+                std::cerr << "ERROR::RECORDINGREADER::Could not decode block " << i << std::endl;
+                return SampleSpan();
+            }
+            return SampleSpan(scratch.data(), scratch.size());
+        }
+        if (reinterpret_cast<std::uintptr_t>(payload) % alignof(Sample) == 0) {
+            // Raw blocks are 8-byte aligned inside the mapping: hand out the mapped bytes directly
+            return SampleSpan(reinterpret_cast<const Sample*>(payload), blockHeader.sampleCount);
+        }
+        scratch.resize(blockHeader.sampleCount);
+        std::memcpy(scratch.data(), payload, blockHeader.sampleCount * sizeof(Sample));
+        return SampleSpan(scratch.data(), scratch.size());
+    }
+
+} // namespace SkyLine
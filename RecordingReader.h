@@ -0,0 +1,58 @@
+#ifndef SKYLINE_RECORDINGREADER_H
+#define SKYLINE_RECORDINGREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "RecordingFormat.h"
+
+namespace SkyLink {
+
+    // Read side of the flight recorder: maps every segment of a recording,
+    // validates the blocks and keeps a sparse, time-ordered block index.
+    // Segments are read in order up to the first one that is missing or
+    // belongs to another session.
+    class RecordingReader {
+    public:
+        struct BlockRef {
+            std::uint32_t segment;
+            std::uint64_t offset;      // of the BlockHeader inside the segment
+            std::int64_t firstTimestamp;
+            std::int64_t lastTimestamp;
+            std::uint32_t sampleCount;
+        };
+
+        bool open(const std::string& basePath);
+        void close();
+
+        std::size_t blockCount() const { return index.size(); }
+        const BlockRef& block(std::size_t i) const { return index[i]; }
+        std::uint64_t sampleCount() const { return totalSamples; }
+        std::uint64_t corruptBlocks() const { return badBlocks; }
+        std::int64_t startTime() const;
+        std::int64_t endTime() const;
+
+        // Index of the block that contains timestamp, O(log n)
+        std::size_t findBlock(std::int64_t timestamp) const;
+
+        // Samples of block i; scratch is used when the block must be decoded.
+        // Returns an empty span if a compressed block fails to decode.
+        SampleSpan blockSamples(std::size_t i, std::vector<Sample>& scratch) const;
+
+    private:
+        bool belongsToSession(const MappedFile& file, std::uint32_t segment) const;
+        void indexSegment(std::uint32_t segment);
+
+        std::vector<std::unique_ptr<MappedFile>> segments;
+        std::vector<BlockRef> index;
+        std::uint64_t sessionId = 0;
+        std::uint64_t totalSamples = 0;
+        std::uint64_t badBlocks = 0;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_RECORDINGREADER_H
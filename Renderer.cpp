@@ -94,7 +94,7 @@ namespace SkyLink {
     }
 
     // renderText fonksiyonunun implementasyonu
-    void Renderer::renderText(const std::string& text, GLfloat x, GLfloat y,
+    void Renderer::renderText(std::string_view text, GLfloat x, GLfloat y,
         GLfloat scale, glm::vec3 color) {
         glUseProgram(textShaderProgram);
         glUniform3f(glGetUniformLocation(textShaderProgram, "textColor"), color.x, color.y, color.z);
@@ -111,9 +111,8 @@ namespace SkyLink {
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE,
             4 * sizeof(GLfloat), 0);
 
-        std::string::const_iterator c;
-        for (c = text.begin(); c != text.end(); c++) {
-            Character ch = Characters[*c];
+        for (char c : text) {
+            const Character& ch = Characters[c];
 
             GLfloat xpos = x + ch.BearingX * scale;
             GLfloat ypos = y - (ch.Height - ch.BearingY) * scale;
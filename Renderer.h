@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include <map>
 #include <string>
+#include <string_view>
 
 namespace SkyLink {
 
@@ -33,7 +34,7 @@ namespace SkyLink {
         ~Renderer();
 
         void clear();
-        void renderText(const std::string& text, GLfloat x, GLfloat y,
+        void renderText(std::string_view text, GLfloat x, GLfloat y,
             GLfloat scale, glm::vec3 color);
         void drawTriangle(float x, float y, float size, glm::vec3 color);
 
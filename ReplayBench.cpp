@@ -0,0 +1,153 @@
+// Replay of a recorded session spread over several segments: unpaced, every
+// sample must come back once, in order. Paced at twice real time after a
+// seek into the middle, only samples from the seek target on may come back,
+// in order, none before its due time, and the whole tail must take about
+// half its recorded span.
+#include "Bench.h"
+#include "DataProvider.h"
+#include "FlightRecorder.h"
+#include "ReplaySource.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const char* const BasePath = "skylinkbench-replay";
+        const std::size_t SegmentBytes = 16 * 1024;
+        const std::int64_t Millisecond = 1000ll * 1000;
+        const std::int64_t Start = 1000 * Millisecond; // recorded timestamps start here
+        const std::int64_t Step = 5 * Millisecond;
+        const std::size_t Steps = 400;                   // 2 s recorded
+        const ChannelId Channels = 3;
+
+        typedef std::chrono::steady_clock Clock;
+
+        class Arrivals : public Observer {
+        public:
+            std::vector<Sample> samples;
+            std::vector<Clock::time_point> times;
+
+            void onSamples(SampleSpan batch) override {
+                const Clock::time_point now = Clock::now();
+                for (const Sample& sample : batch) {
+                    samples.push_back(sample);
+                    times.push_back(now);
+                }
+            }
+        };
+
+        bool recordSession(std::string& session) {
+            FlightRecorder recorder;
+            if (!recorder.open(BasePath, SegmentBytes)) {
+                return false;
+            }
+            std::vector<Sample> batch;
+            for (std::size_t step = 0; step < Steps; step += 50) {
+                batch.clear();
+                for (std::size_t i = step; i < step + 50; ++i) {
+                    for (ChannelId channel = 0; channel < Channels; ++channel) {
+                        batch.push_back(Sample::fromInt(channel, Start + static_cast<std::int64_t>(i) * Step,
+                            static_cast<std::int64_t>(i)));
+                    }
+                }
+                recorder.append(SampleSpan(batch.data(), batch.size()));
+            }
+            session = recorder.sessionPath();
+            const bool spread = recorder.segmentCount() > 1;
+            recorder.close();
+            return spread;
+        }
+
+        void removeSession(const std::string& session) {
+            for (std::uint32_t index = 0; MappedFile::exists(recordingSegmentPath(session, index)); ++index) {
+                MappedFile::remove(recordingSegmentPath(session, index));
+            }
+        }
+
+        // Drains on this thread, as the frame loop would, until the replay ran out
+        void collect(ReplaySource& replay, DataProvider& provider) {
+            for (;;) {
+                const bool done = replay.isFinished(); // before the drain, so nothing posted is left behind
+                provider.drain();
+                if (done) {
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        bool inOrder(const std::vector<Sample>& samples) {
+            for (std::size_t i = 1; i < samples.size(); ++i) {
+                if (samples[i].timestamp < samples[i - 1].timestamp) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    } // namespace
+
+    bool benchReplay() {
+        std::string session;
+        if (!recordSession(session)) {
+            removeSession(session);
+            return false;
+        }
+
+        // Unpaced, start to end
+        DataProvider provider;
+        Arrivals whole;
+        provider.attach(&whole);
+        ReplaySource replay(provider);
+        bool opened = replay.open(session);
+        replay.setSpeed(ReplaySource::AsFastAsPossible);
+        replay.start();
+        collect(replay, provider);
+        const bool wholeIntact = opened && whole.samples.size() == Steps * Channels && inOrder(whole.samples) &&
+            whole.samples.front().timestamp == Start;
+        std::printf("unpaced: %zu of %zu samples, in order: %s\n", whole.samples.size(), Steps * Channels,
+            inOrder(whole.samples) ? "yes" : "no");
+        provider.detach(&whole);
+
+        // Twice real time from the middle of the recording; the target sits between samples
+        const double Speed = 2.0;
+        const std::int64_t target = Start + static_cast<std::int64_t>(Steps / 2) * Step - Step / 2;
+        const std::size_t expected = (Steps / 2) * Channels;
+        Arrivals tail;
+        provider.attach(&tail);
+        opened = replay.open(session);
+        replay.setSpeed(Speed);
+        replay.seek(target);
+        const Clock::time_point started = Clock::now();
+        replay.start();
+        collect(replay, provider);
+        const double seconds = secondsSince(started);
+        replay.stop();
+        provider.detach(&tail);
+
+        std::size_t early = 0;
+        for (std::size_t i = 0; i < tail.samples.size(); ++i) {
+            const std::int64_t dueNs = static_cast<std::int64_t>((tail.samples[i].timestamp - target) / Speed);
+            if (tail.times[i] + std::chrono::milliseconds(1) < started + std::chrono::nanoseconds(dueNs)) {
+                ++early;
+            }
+        }
+        const double span = static_cast<double>(Start + static_cast<std::int64_t>(Steps - 1) * Step - target) / 1e9 / Speed;
+        const bool tailOrdered = inOrder(tail.samples);
+        const bool fromTarget = !tail.samples.empty() && tail.samples.front().timestamp >= target &&
+            tail.samples.front().timestamp < target + Step;
+        std::printf("seek, %.0fx: %zu of %zu samples, in order: %s, from target: %s, %zu early; "
+            "%.3f s for a %.3f s tail\n", Speed, tail.samples.size(), expected, tailOrdered ? "yes" : "no",
+            fromTarget ? "yes" : "no", early, seconds, span);
+
+        removeSession(session);
+        return wholeIntact && opened && tail.samples.size() == expected && tailOrdered && fromTarget && early == 0 &&
+            seconds > span - 0.001 && seconds < span * 1.5 + 0.05;
+    }
+
+} // namespace SkyLine
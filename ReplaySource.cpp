@@ -0,0 +1,125 @@
+#include "ReplaySource.h"
+#include "DataProvider.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace SkyLink {
+
+    ReplaySource::ReplaySource(DataProvider& target)
+        : target(target), running(false), finished(false), speed(1.0), speedChanged(false),
+        seekRequest(NoSeek), cursor(0), replayed(0) {}
+
+    ReplaySource::~ReplaySource() {
+        stop();
+    }
+
+    bool ReplaySource::open(const std::string& basePath) {
+        stop();
+        if (!reader.open(basePath)) {
+            return false;
+        }
+        cursor.store(reader.startTime(), std::memory_order_relaxed);
+        seekRequest.store(reader.startTime(), std::memory_order_relaxed);
+        finished.store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+    void ReplaySource::start() {
+        if (running.load() || reader.blockCount() == 0) {
+            return;
+        }
+        if (finished.load()) {
+            // Restart from the beginning unless a seek is already pending
+            std::int64_t pending = NoSeek;
+            seekRequest.compare_exchange_strong(pending, reader.startTime());
+        }
+        finished.store(false);
+        running.store(true, std::memory_order_release);
+        worker = std::thread(&ReplaySource::run, this);
+    }
+
+    void ReplaySource::stop() {
+        running.store(false, std::memory_order_release);
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void ReplaySource::setSpeed(double newSpeed) {
+        speed.store(newSpeed < 0.0 ? AsFastAsPossible : newSpeed, std::memory_order_relaxed);
+        speedChanged.store(true, std::memory_order_release);
+    }
+
+    void ReplaySource::seek(std::int64_t timestamp) {
+        seekRequest.store(timestamp, std::memory_order_release);
+    }
+
+    void ReplaySource::run() {
+        typedef std::chrono::steady_clock Clock;
+
+        std::vector<Sample> scratch;
+        std::size_t blockIndex = 0;
+        SampleSpan block;
+        std::size_t sampleIndex = 0;
+
+        double currentSpeed = speed.load();
+        Clock::time_point anchorWall = Clock::now();
+        std::int64_t anchorTime = cursor.load();
+
+        while (running.load(std::memory_order_acquire)) {
+            const std::int64_t seekTarget = seekRequest.exchange(NoSeek, std::memory_order_acq_rel);
+            if (seekTarget != NoSeek) {
+                blockIndex = reader.findBlock(seekTarget);
+                block = reader.blockSamples(blockIndex, scratch);
+                sampleIndex = 0;
+                while (sampleIndex < block.size() && block[sampleIndex].timestamp < seekTarget) {
+                    ++sampleIndex;
+                }
+                currentSpeed = speed.load();
+                anchorWall = Clock::now();
+                anchorTime = seekTarget;
+                cursor.store(seekTarget, std::memory_order_relaxed);
+            }
+            else if (speedChanged.exchange(false, std::memory_order_acq_rel)) {
+                // Re-anchor the clock at the current position
+                currentSpeed = speed.load();
+                anchorWall = Clock::now();
+                anchorTime = cursor.load(std::memory_order_relaxed);
+            }
+
+            if (sampleIndex >= block.size()) {
+                if (blockIndex + 1 >= reader.blockCount()) {
+                    finished.store(true, std::memory_order_release);
+                    running.store(false, std::memory_order_release);
+                    break;
+                }
+                block = reader.blockSamples(++blockIndex, scratch);
+                sampleIndex = 0;
+                continue;
+            }
+
+            const Sample& sample = block[sampleIndex];
+            if (currentSpeed > 0.0) {
+                const double elapsed = static_cast<double>(sample.timestamp - anchorTime) / currentSpeed;
+                const Clock::time_point due = anchorWall + std::chrono::nanoseconds(static_cast<std::int64_t>(elapsed));
+                const Clock::time_point now = Clock::now();
+                if (due > now + std::chrono::microseconds(500)) {
+                    // Sleep in short slices so stop/seek stay responsive
+                    std::this_thread::sleep_for(std::min<Clock::duration>(due - now, std::chrono::milliseconds(5)));
+                    continue;
+                }
+            }
+
+            // Deterministic replay: wait for the frame loop instead of dropping
+            if (!target.tryPost(sample)) {
+                std::this_thread::yield();
+                continue;
+            }
+            cursor.store(sample.timestamp, std::memory_order_relaxed);
+            replayed.fetch_add(1, std::memory_order_relaxed);
+            ++sampleIndex;
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,60 @@
+#ifndef SKYLINE_REPLAYSOURCE_H
+#define SKYLINE_REPLAYSOURCE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "RecordingReader.h"
+
+namespace SkyLink {
+
+    class DataProvider;
+
+    // Plays a flight recording back into a DataProvider on its own thread,
+    // in place of a live receiver. Samples keep their recorded timestamps.
+    class ReplaySource {
+    public:
+        static constexpr double AsFastAsPossible = 0.0;
+
+        explicit ReplaySource(DataProvider& target);
+        ~ReplaySource();
+
+        bool open(const std::string& basePath);
+
+        void start();
+        void stop();
+        bool isRunning() const { return running.load(std::memory_order_acquire); }
+        bool isFinished() const { return finished.load(std::memory_order_acquire); }
+
+        // 1.0 = real time, 10.0 = ten times faster, AsFastAsPossible = no pacing
+        void setSpeed(double speed);
+        // Jumps to the first sample at or after timestamp; safe while running
+        void seek(std::int64_t timestamp);
+
+        std::int64_t position() const { return cursor.load(std::memory_order_relaxed); }
+        std::int64_t startTime() const { return reader.startTime(); }
+        std::int64_t endTime() const { return reader.endTime(); }
+        std::uint64_t samplesReplayed() const { return replayed.load(std::memory_order_relaxed); }
+
+    private:
+        void run();
+
+        static constexpr std::int64_t NoSeek = INT64_MIN;
+
+        RecordingReader reader;
+        DataProvider& target;
+        std::thread worker;
+
+        std::atomic<bool> running;
+        std::atomic<bool> finished;
+        std::atomic<double> speed;
+        std::atomic<bool> speedChanged;
+        std::atomic<std::int64_t> seekRequest;
+        std::atomic<std::int64_t> cursor;
+        std::atomic<std::uint64_t> replayed;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_REPLAYSOURCE_H
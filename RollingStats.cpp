@@ -0,0 +1,159 @@
+#include "RollingStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SkyLink {
+
+    namespace {
+
+        // Once removals bring m2 below this share of its peak, the rounding
+        // error of the larger values it held (a spike or an old level leaving
+        // the window) swamps what is left, so the moments are recomputed
+        const double CancellationRatio = 1e-3;
+
+    } // namespace
+
+    RollingStats::RollingStats(std::size_t channelCount, std::size_t windowSamples, std::int64_t windowDuration)
+        : channels(channelCount), window(windowSamples < 1 ? 1 : windowSamples), duration(windowDuration),
+        published(new Seqlock<Snapshot>[channelCount]) {
+        std::uint64_t capacity = 1;
+        while (capacity < window) {
+            capacity <<= 1;
+        }
+        mask = capacity - 1;
+
+        state.resize(channels, Channel{ 0, 0, 0, 0, 0, 0, 0.0, 0.0, 0.0 });
+        values.resize(channels * capacity);
+        timestamps.resize(channels * capacity);
+        minQueues.resize(channels * capacity);
+        maxQueues.resize(channels * capacity);
+    }
+
+    void RollingStats::process(Sample* samples, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            add(samples[i]);
+        }
+    }
+
+    void RollingStats::add(const Sample& sample) {
+        if (sample.channel >= channels) {
+            return;
+        }
+        const std::size_t base = static_cast<std::size_t>(sample.channel) * (mask + 1);
+        Channel& s = state[sample.channel];
+        double* ring = values.data() + base;
+        std::int64_t* times = timestamps.data() + base;
+        std::uint64_t* minQueue = minQueues.data() + base;
+        std::uint64_t* maxQueue = maxQueues.data() + base;
+        const double x = sample.asDouble();
+        if (std::isnan(x)) {
+            return; // would poison the running sums
+        }
+
+        bool cancelled = false;
+        if (s.tail - s.head == window) {
+            cancelled |= evictOldest(s, ring, minQueue, maxQueue);
+        }
+        if (duration > 0) {
+            while (s.tail != s.head && times[s.head & mask] <= sample.timestamp - duration) {
+                cancelled |= evictOldest(s, ring, minQueue, maxQueue);
+            }
+        }
+
+        const std::uint64_t seq = s.tail++;
+        ring[seq & mask] = x;
+        times[seq & mask] = sample.timestamp;
+
+        if ((seq & mask) == mask || cancelled) {
+            // Once per ring lap, or after a removal lost precision, recompute
+            // exactly so add/remove rounding cannot accumulate
+            double sum = 0.0;
+            for (std::uint64_t i = s.head; i != s.tail; ++i) {
+                sum += ring[i & mask];
+            }
+            s.mean = sum / static_cast<double>(s.tail - s.head);
+            s.m2 = 0.0;
+            for (std::uint64_t i = s.head; i != s.tail; ++i) {
+                const double d = ring[i & mask] - s.mean;
+                s.m2 += d * d;
+            }
+            s.m2Peak = s.m2;
+        }
+        else {
+            const double n = static_cast<double>(s.tail - s.head);
+            const double delta = x - s.mean;
+            s.mean += delta / n;
+            s.m2 += delta * (x - s.mean);
+            s.m2Peak = std::max(s.m2Peak, s.m2);
+        }
+
+        while (s.minTail != s.minHead && ring[minQueue[(s.minTail - 1) & mask] & mask] >= x) {
+            --s.minTail;
+        }
+        minQueue[s.minTail++ & mask] = seq;
+        while (s.maxTail != s.maxHead && ring[maxQueue[(s.maxTail - 1) & mask] & mask] <= x) {
+            --s.maxTail;
+        }
+        maxQueue[s.maxTail++ & mask] = seq;
+
+        publish(sample.channel, s, sample.timestamp);
+    }
+
+    bool RollingStats::evictOldest(Channel& s, double* ring, std::uint64_t* minQueue, std::uint64_t* maxQueue) {
+        const std::uint64_t seq = s.head++;
+        const double x = ring[seq & mask];
+        const double n = static_cast<double>(s.tail - s.head);
+        bool cancelled = false;
+        if (n == 0) {
+            s.mean = 0.0;
+            s.m2 = 0.0;
+            s.m2Peak = 0.0;
+        }
+        else {
+            const double delta = x - s.mean;
+            s.mean -= delta / n;
+            s.m2 -= delta * (x - s.mean);
+            if (s.m2 < 0.0) {
+                s.m2 = 0.0; // rounding after many removals
+            }
+            cancelled = s.m2 < s.m2Peak * CancellationRatio;
+        }
+        if (s.minTail != s.minHead && minQueue[s.minHead & mask] == seq) {
+            ++s.minHead;
+        }
+        if (s.maxTail != s.maxHead && maxQueue[s.maxHead & mask] == seq) {
+            ++s.maxHead;
+        }
+        return cancelled;
+    }
+
+    void RollingStats::publish(ChannelId channel, const Channel& s, std::int64_t timestamp) {
+        const std::uint64_t count = s.tail - s.head;
+        const std::size_t base = static_cast<std::size_t>(channel) * (mask + 1);
+        Snapshot snap;
+        snap.timestamp = timestamp;
+        snap.count = count;
+        snap.mean = s.mean;
+        snap.stddev = count > 1 ? std::sqrt(s.m2 / static_cast<double>(count - 1)) : 0.0;
+        snap.min = values[base + (minQueues[base + (s.minHead & mask)] & mask)];
+        snap.max = values[base + (maxQueues[base + (s.maxHead & mask)] & mask)];
+        published[channel].store(snap);
+    }
+
+    void RollingStats::reset(ChannelId channel) {
+        if (channel >= channels) {
+            return;
+        }
+        state[channel] = Channel{ 0, 0, 0, 0, 0, 0, 0.0, 0.0, 0.0 };
+        published[channel].store(Snapshot{ 0, 0, 0.0, 0.0, 0.0, 0.0 });
+    }
+
+    bool RollingStats::snapshot(ChannelId channel, Snapshot& out) const {
+        if (channel >= channels) {
+            return false;
+        }
+        out = published[channel].load();
+        return out.count > 0;
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,68 @@
+#ifndef SKYLINE_ROLLINGSTATS_H
+#define SKYLINE_ROLLINGSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Sample.h"
+#include "Seqlock.h"
+#include "TelemetryStage.h"
+
+namespace SkyLink {
+
+    // Rolling mean, standard deviation, min and max per channel over the last
+    // windowSamples samples, optionally also bounded to windowDuration ns.
+    // Each sample costs O(1) amortized: Welford add/remove for the moments,
+    // monotonic deques for the extremes. Run it as a DataProvider stage (one
+    // writer); snapshot() can be called from any thread without locking.
+    class RollingStats : public TelemetryStage {
+    public:
+        struct Snapshot {
+            std::int64_t timestamp; // newest sample in the window
+            std::uint64_t count;
+            double mean;
+            double stddev;          // sample standard deviation
+            double min;
+            double max;
+        };
+
+        RollingStats(std::size_t channelCount, std::size_t windowSamples, std::int64_t windowDuration = 0);
+
+        void process(Sample* samples, std::size_t count) override;
+        void add(const Sample& sample);
+        void reset(ChannelId channel);
+
+        bool snapshot(ChannelId channel, Snapshot& out) const;
+        std::size_t channelCount() const { return channels; }
+        std::size_t windowSize() const { return window; }
+
+    private:
+        struct Channel {
+            std::uint64_t head, tail;       // window ring, sample sequence numbers
+            std::uint64_t minHead, minTail; // monotonic deques of sequence numbers
+            std::uint64_t maxHead, maxTail;
+            double mean, m2;
+            double m2Peak; // largest m2 since the last exact recompute
+        };
+
+        // Returns true when m2 has cancelled down to a sliver of its peak and needs recomputing
+        bool evictOldest(Channel& state, double* values, std::uint64_t* minQueue, std::uint64_t* maxQueue);
+        void publish(ChannelId channel, const Channel& state, std::int64_t timestamp);
+
+        std::size_t channels;
+        std::size_t window;
+        std::int64_t duration;
+        std::uint64_t mask; // ring capacity - 1, capacity is a power of two >= window
+
+        std::vector<Channel> state;
+        std::vector<double> values;            // [channel * capacity + seq & mask]
+        std::vector<std::int64_t> timestamps;
+        std::vector<std::uint64_t> minQueues;
+        std::vector<std::uint64_t> maxQueues;
+        std::unique_ptr<Seqlock<Snapshot>[]> published;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_ROLLINGSTATS_H
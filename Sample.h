@@ -0,0 +1,80 @@
+#ifndef SKYLINE_SAMPLE_H
+#define SKYLINE_SAMPLE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace SkyLink {
+
+    typedef std::uint32_t ChannelId;
+
+    enum class SampleType : std::uint32_t {
+        Int = 0,
+        Double = 1
+    };
+
+    // One telemetry value. Trivially copyable (24 bytes) so batches can be
+    // moved through queues and files with plain memcpy.
+    struct Sample {
+        ChannelId channel;
+        SampleType type;
+        std::int64_t timestamp; // nanoseconds, see nowNanoseconds()
+        union {
+            std::int64_t intValue;
+            double doubleValue;
+        };
+
+        static Sample fromInt(ChannelId channel, std::int64_t timestamp, std::int64_t value) {
+            Sample sample;
+            sample.channel = channel;
+            sample.type = SampleType::Int;
+            sample.timestamp = timestamp;
+            sample.intValue = value;
+            return sample;
+        }
+
+        static Sample fromDouble(ChannelId channel, std::int64_t timestamp, double value) {
+            Sample sample;
+            sample.channel = channel;
+            sample.type = SampleType::Double;
+            sample.timestamp = timestamp;
+            sample.doubleValue = value;
+            return sample;
+        }
+
+        double asDouble() const {
+            return type == SampleType::Int ? static_cast<double>(intValue) : doubleValue;
+        }
+
+        std::int64_t asInt() const {
+            return type == SampleType::Int ? intValue : static_cast<std::int64_t>(doubleValue);
+        }
+    };
+
+    // Read-only view over a contiguous run of samples
+    class SampleSpan {
+    public:
+        SampleSpan() : first(nullptr), count(0) {}
+        SampleSpan(const Sample* first, std::size_t count) : first(first), count(count) {}
+
+        const Sample* begin() const { return first; }
+        const Sample* end() const { return first + count; }
+        const Sample* data() const { return first; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const Sample& operator[](std::size_t index) const { return first[index]; }
+
+    private:
+        const Sample* first;
+        std::size_t count;
+    };
+
+    inline std::int64_t nowNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+} // namespace SkyLine
+
+#endif // SKYLINE_SAMPLE_H
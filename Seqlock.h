@@ -0,0 +1,80 @@
+#ifndef SKYLINE_SEQLOCK_H
+#define SKYLINE_SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace SkyLink {
+
+    // Single-writer, many-reader slot for a small trivially copyable value.
+    // The writer never waits; a reader retries if it overlapped a write.
+    // The payload is kept in atomic words so the overlapping read is not a
+    // data race, only a torn copy that the sequence check throws away.
+    template <typename T>
+    class alignas(64) Seqlock {
+        static_assert(std::is_trivially_copyable<T>::value, "Seqlock needs a trivially copyable type");
+        static const std::size_t WordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    public:
+        Seqlock() : sequence(0) {
+            for (auto& word : words) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        Seqlock(const Seqlock&) = delete;
+        Seqlock& operator=(const Seqlock&) = delete;
+
+        // Writer side
+        void store(const T& value) {
+            std::uint64_t buffer[WordCount] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+
+            const std::uint32_t s = sequence.load(std::memory_order_relaxed);
+            sequence.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < WordCount; ++i) {
+                words[i].store(buffer[i], std::memory_order_relaxed);
+            }
+            sequence.store(s + 2, std::memory_order_release);
+        }
+
+        // Reader side; false if a write was in progress
+        bool tryLoad(T& value) const {
+            const std::uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                return false;
+            }
+            std::uint64_t buffer[WordCount];
+            for (std::size_t i = 0; i < WordCount; ++i) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != before) {
+                return false;
+            }
+            std::memcpy(&value, buffer, sizeof(T));
+            return true;
+        }
+
+        T load() const {
+            T value;
+            while (!tryLoad(value)) {
+            }
+            return value;
+        }
+
+        // Number of completed writes
+        std::uint32_t version() const { return sequence.load(std::memory_order_acquire) >> 1; }
+
+    private:
+        std::atomic<std::uint32_t> sequence;
+        std::atomic<std::uint64_t> words[WordCount];
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_SEQLOCK_H
@@ -0,0 +1,103 @@
+// Sequence tracking on a link that goes quiet: frames held behind a gap must
+// come out of MavlinkDecoder::tick() once maxHold has passed, without another
+// frame arriving, and flush() must release what is left at end of stream.
+// A packet too large for the reorder slots is counted, not silently lost.
+#include "Bench.h"
+#include "DataProvider.h"
+#include "MavlinkDecoder.h"
+#include <algorithm>
+#include <cstdio>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::int64_t Hold = 20ll * 1000 * 1000; // 20 ms
+
+        class Collector : public Observer {
+        public:
+            std::vector<double> values;
+
+            void onSamples(SampleSpan samples) override {
+                for (const Sample& sample : samples) {
+                    values.push_back(sample.asDouble());
+                }
+            }
+        };
+
+        void feed(MavlinkDecoder& decoder, std::initializer_list<std::uint8_t> sequences) {
+            for (std::uint8_t sequence : sequences) {
+                const std::vector<std::uint8_t> frame = attitudeFrame(sequence, sequence, sequence); // roll carries the sequence number
+                decoder.feed(frame.data(), frame.size());
+            }
+        }
+
+        bool sameValues(const std::vector<double>& values, std::initializer_list<double> expected) {
+            return values.size() == expected.size() && std::equal(values.begin(), values.end(), expected.begin());
+        }
+
+        // Tracker alone, 8-byte slots: sequence 2 does not fit and must still be accounted for
+        bool oversizeCounted() {
+            SequenceTracker tracker(8, 16, 8, Hold);
+            std::vector<std::uint32_t> released;
+            const auto release = [&released](const std::uint8_t*, std::size_t, std::uint32_t tag, std::int64_t) {
+                released.push_back(tag);
+            };
+            const std::uint8_t small[8] = {};
+            const std::uint8_t large[16] = {};
+            tracker.receive(0, small, sizeof(small), 0, 0, release);
+            tracker.receive(2, large, sizeof(large), 2, 1, release);
+            tracker.receive(1, small, sizeof(small), 1, 2, release);
+            tracker.receive(3, small, sizeof(small), 3, 3, release);
+            const bool heldBehindOversize = tracker.held() == 1;
+            tracker.tick(3 + Hold + 1, release);
+            return heldBehindOversize && tracker.oversizeCount() == 1 && tracker.gapCount() == 1 && tracker.held() == 0 &&
+                released == std::vector<std::uint32_t>{ 0, 1, 3 };
+        }
+
+    } // namespace
+
+    bool benchSequenceTracking() {
+        DataProvider provider(1024);
+        Collector roll;
+        Collector stats;
+        provider.attach(&roll, 0);
+        provider.attach(&stats, 11); // first link statistics channel: gaps
+
+        MavlinkDecoder decoder(provider);
+        decoder.setLinkStatsChannel(decoder.bindCommonTelemetry(0), Hold / 2);
+        decoder.trackSequences(16, Hold);
+
+        // 1 is lost; 2 and 3 wait for it and nothing else arrives
+        feed(decoder, { 0, 2, 3 });
+        provider.drain();
+        std::this_thread::sleep_for(std::chrono::nanoseconds(2 * Hold));
+        provider.drain();
+        const bool heldWhileQuiet = sameValues(roll.values, { 0.0 }) && decoder.link(0).held() == 2;
+        const std::size_t statsBefore = stats.values.size();
+
+        decoder.tick();
+        provider.drain();
+        const bool tickReleases = sameValues(roll.values, { 0.0, 2.0, 3.0 }) && decoder.link(0).gapCount() == 1 &&
+            decoder.link(0).held() == 0;
+        const bool tickPostsStats = stats.values.size() > statsBefore && stats.values.back() == 1.0;
+
+        // 4 is lost and the stream ends
+        feed(decoder, { 5, 6 });
+        provider.drain();
+        decoder.flush();
+        provider.drain();
+        const bool flushReleases = sameValues(roll.values, { 0.0, 2.0, 3.0, 5.0, 6.0 }) && decoder.link(0).held() == 0;
+
+        const bool oversize = oversizeCounted();
+
+        std::printf("held while quiet: %s, tick releases: %s, tick posts link stats: %s, flush releases: %s, oversize counted: %s\n",
+            heldWhileQuiet ? "yes" : "no", tickReleases ? "yes" : "no", tickPostsStats ? "yes" : "no",
+            flushReleases ? "yes" : "no", oversize ? "yes" : "no");
+        return heldWhileQuiet && tickReleases && tickPostsStats && flushReleases && oversize;
+    }
+
+} // namespace SkyLine
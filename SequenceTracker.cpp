@@ -0,0 +1,110 @@
+#include "SequenceTracker.h"
+#include "DataProvider.h"
+#include <bitset>
+#include <cstring>
+
+namespace SkyLink {
+
+    SequenceTracker::SequenceTracker(unsigned sequenceBits, std::size_t window, std::size_t maxPacketBytes, std::int64_t maxHold)
+        : slotBytes(maxPacketBytes), maxHold(maxHold),
+        statsTarget(nullptr), statsChannel(0), statsInterval(0), nextStats(0),
+        heldCount(0), received(0), gaps(0), duplicates(0), late(0), reordered(0), oversize(0) {
+        if (sequenceBits < 2) {
+            sequenceBits = 2;
+        }
+        if (sequenceBits > 32) {
+            sequenceBits = 32;
+        }
+        sequenceMask = sequenceBits == 32 ? 0xFFFFFFFFu : (1u << sequenceBits) - 1;
+
+        // The window must stay below half the counter range so ahead and behind stay distinguishable
+        std::size_t limit = MaxWindow;
+        if (sequenceBits <= 7) {
+            limit = std::size_t(1) << (sequenceBits - 1);
+        }
+        slotCount = 1;
+        while (slotCount < window && slotCount < limit) {
+            slotCount <<= 1;
+        }
+        slotMask = static_cast<std::uint32_t>(slotCount - 1);
+        slots.resize(slotCount);
+        storage.resize(slotCount * slotBytes);
+        reset();
+    }
+
+    void SequenceTracker::reset() {
+        started = false;
+        expected = 0;
+        pending = 0;
+        history = 0;
+        lateRun = 0;
+        updateHeld();
+    }
+
+    void SequenceTracker::setStatsOutput(DataProvider* target, ChannelId firstChannel, std::int64_t interval) {
+        statsTarget = target;
+        statsChannel = firstChannel;
+        statsInterval = interval;
+        nextStats = 0;
+    }
+
+    bool SequenceTracker::behind(std::uint32_t sequence) {
+        const std::uint32_t offset = (sequence - expected) & sequenceMask;
+        if (offset <= (sequenceMask >> 1)) {
+            lateRun = 0;
+            return false;
+        }
+        const std::uint32_t back = (expected - sequence) & sequenceMask;
+        if (back <= 64 && (history & (1ull << (back - 1)))) {
+            bump(duplicates);
+        }
+        else {
+            bump(late);
+        }
+        ++lateRun;
+        return true;
+    }
+
+    bool SequenceTracker::store(std::size_t offset, const std::uint8_t* data, std::size_t size, std::uint32_t tag, std::int64_t now) {
+        if (size > slotBytes) {
+            return false; // cannot be held, its number will be counted as a gap once given up
+        }
+        const std::size_t index = (expected + offset) & slotMask;
+        Slot& slot = slots[index];
+        slot.size = static_cast<std::uint32_t>(size);
+        slot.tag = tag;
+        slot.arrival = now;
+        if (size > 0) {
+            std::memcpy(storage.data() + index * slotBytes, data, size);
+        }
+        pending |= 1ull << offset;
+        return true;
+    }
+
+    void SequenceTracker::skip(std::uint32_t count) {
+        if (count == 0) {
+            return;
+        }
+        bump(gaps, count);
+        expected = (expected + count) & sequenceMask;
+        pending = count >= 64 ? 0 : pending >> count;
+        history = count >= 64 ? 0 : history << count;
+    }
+
+    void SequenceTracker::updateHeld() {
+        heldCount.store(std::bitset<64>(pending).count(), std::memory_order_relaxed);
+    }
+
+    void SequenceTracker::maybePostStats(std::int64_t now) {
+        if (statsTarget == nullptr || now < nextStats) {
+            return;
+        }
+        nextStats = now + statsInterval;
+        statsTarget->post(Sample::fromInt(statsChannel, now, static_cast<std::int64_t>(gapCount())));
+        statsTarget->post(Sample::fromInt(statsChannel + 1, now, static_cast<std::int64_t>(duplicateCount())));
+        statsTarget->post(Sample::fromInt(statsChannel + 2, now, static_cast<std::int64_t>(lateCount())));
+        statsTarget->post(Sample::fromInt(statsChannel + 3, now, static_cast<std::int64_t>(reorderedCount())));
+        statsTarget->post(Sample::fromInt(statsChannel + 4, now, static_cast<std::int64_t>(held())));
+    }
+
+} // namespace SkyLine
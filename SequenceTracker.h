@@ -0,0 +1,256 @@
+#ifndef SKYLINE_SEQUENCETRACKER_H
+#define SKYLINE_SEQUENCETRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Sample.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace SkyLink {
+
+    class DataProvider;
+
+    // Puts one source's packets back into sequence-number order on a lossy
+    // link. Packets ahead of the next expected number wait in a fixed reorder
+    // window (bitmap of occupied slots plus a preallocated slot array); a gap
+    // is given up once the window overflows or its oldest packet has waited
+    // maxHold. There are no locks inside: receive(), tick() and flush() all run
+    // on the receive thread. Counters are single-writer atomics the UI may
+    // read, and can also be posted as telemetry through setStatsOutput().
+    class SequenceTracker {
+    public:
+        static const std::size_t MaxWindow = 64; // one bitmap word
+        static const std::size_t StatsChannels = 5; // gaps, duplicates, late, reordered, held
+        static const std::int64_t DefaultMaxHold = 50ll * 1000 * 1000; // 50 ms
+
+        // sequenceBits: width of the wrapping counter (8 for MAVLink, 14 for CCSDS).
+        // window is rounded up to a power of two and capped by MaxWindow and the counter range.
+        SequenceTracker(unsigned sequenceBits, std::size_t window = 16, std::size_t maxPacketBytes = 280,
+            std::int64_t maxHold = DefaultMaxHold);
+
+        SequenceTracker(const SequenceTracker&) = delete;
+        SequenceTracker& operator=(const SequenceTracker&) = delete;
+
+        // Receive thread. release(const uint8_t* data, size_t size, uint32_t tag, int64_t arrival)
+        // is called for every packet that can go out in order, possibly several per call.
+        // tag is a caller word kept with the packet (message id, APID, ...).
+        template <typename Handler>
+        void receive(std::uint32_t sequence, const std::uint8_t* data, std::size_t size,
+            std::uint32_t tag, std::int64_t now, Handler&& release);
+
+        // Give up on gaps whose successors have waited longer than maxHold
+        template <typename Handler>
+        void expire(std::int64_t now, Handler&& release);
+
+        // Periodic call between packets: expire() and post the statistics when due,
+        // so a link that goes quiet still releases what it holds
+        template <typename Handler>
+        void tick(std::int64_t now, Handler&& release);
+
+        // Release everything held, skipping all gaps (end of stream)
+        template <typename Handler>
+        void flush(Handler&& release);
+
+        void reset();
+
+        // Post the counters as Int samples on firstChannel.. every interval ns.
+        // target must be fed from the receive thread (it is the queue's producer).
+        void setStatsOutput(DataProvider* target, ChannelId firstChannel, std::int64_t interval = 1000ll * 1000 * 1000);
+
+        std::size_t window() const { return slotCount; }
+        std::size_t held() const { return heldCount.load(std::memory_order_relaxed); }
+        std::uint64_t packetsReceived() const { return received.load(std::memory_order_relaxed); }
+        std::uint64_t gapCount() const { return gaps.load(std::memory_order_relaxed); }             // numbers never delivered
+        std::uint64_t duplicateCount() const { return duplicates.load(std::memory_order_relaxed); }
+        std::uint64_t lateCount() const { return late.load(std::memory_order_relaxed); }            // arrived after their gap was given up
+        std::uint64_t reorderedCount() const { return reordered.load(std::memory_order_relaxed); }  // arrived behind a later number
+        std::uint64_t oversizeCount() const { return oversize.load(std::memory_order_relaxed); }    // too big to hold, dropped and counted as gaps
+
+    private:
+        struct Slot {
+            std::uint32_t size;
+            std::uint32_t tag;
+            std::int64_t arrival;
+        };
+
+        static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        static unsigned lowestBit(std::uint64_t word) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+        }
+
+        bool behind(std::uint32_t sequence);
+        bool store(std::size_t offset, const std::uint8_t* data, std::size_t size, std::uint32_t tag, std::int64_t now);
+        void skip(std::uint32_t count); // advance past count numbers that are not held
+        void maybePostStats(std::int64_t now);
+        void updateHeld();
+
+        template <typename Handler>
+        void deliver(Handler& release);
+        template <typename Handler>
+        void releaseFront(Handler& release);
+        template <typename Handler>
+        void advance(std::uint32_t count, Handler& release);
+
+        std::uint32_t sequenceMask;
+        std::uint32_t slotMask;
+        std::size_t slotCount;
+        std::size_t slotBytes;
+        std::int64_t maxHold;
+
+        bool started;
+        std::uint32_t expected;
+        std::uint64_t pending;   // bit i: expected + i is held
+        std::uint64_t history;   // bit i: expected - 1 - i was delivered
+        std::uint32_t lateRun;   // consecutive packets behind the window, resync after too many
+        std::vector<Slot> slots;
+        std::vector<std::uint8_t> storage;
+
+        DataProvider* statsTarget;
+        ChannelId statsChannel;
+        std::int64_t statsInterval;
+        std::int64_t nextStats;
+
+        std::atomic<std::size_t> heldCount;
+        std::atomic<std::uint64_t> received;
+        std::atomic<std::uint64_t> gaps;
+        std::atomic<std::uint64_t> duplicates;
+        std::atomic<std::uint64_t> late;
+        std::atomic<std::uint64_t> reordered;
+        std::atomic<std::uint64_t> oversize;
+    };
+
+    template <typename Handler>
+    void SequenceTracker::deliver(Handler& release) {
+        const std::size_t index = expected & slotMask;
+        const Slot& slot = slots[index];
+        release(static_cast<const std::uint8_t*>(storage.data() + index * slotBytes),
+            static_cast<std::size_t>(slot.size), slot.tag, slot.arrival);
+        pending >>= 1;
+        history = (history << 1) | 1u;
+        expected = (expected + 1) & sequenceMask;
+    }
+
+    template <typename Handler>
+    void SequenceTracker::releaseFront(Handler& release) {
+        // Deliver the run of held packets starting at the expected number
+        while (pending & 1u) {
+            deliver(release);
+        }
+    }
+
+    template <typename Handler>
+    void SequenceTracker::advance(std::uint32_t count, Handler& release) {
+        // Move the window forward by count numbers, delivering what is held and counting the rest lost
+        while (count > 0) {
+            if (pending & 1u) {
+                deliver(release);
+                --count;
+                continue;
+            }
+            const std::uint32_t missing = pending == 0 ? count : lowestBit(pending);
+            const std::uint32_t step = missing < count ? missing : count;
+            skip(step);
+            count -= step;
+        }
+        releaseFront(release);
+    }
+
+    template <typename Handler>
+    void SequenceTracker::receive(std::uint32_t sequence, const std::uint8_t* data, std::size_t size,
+        std::uint32_t tag, std::int64_t now, Handler&& release) {
+        bump(received);
+        sequence &= sequenceMask;
+        if (!started) {
+            started = true;
+            expected = sequence;
+        }
+        expire(now, release);
+
+        if (behind(sequence)) {
+            if (lateRun <= slotCount) {
+                maybePostStats(now);
+                return;
+            }
+            // A long run of old numbers: the sender restarted, follow it
+            flush(release);
+            expected = sequence;
+            history = 0;
+            lateRun = 0;
+        }
+
+        const std::uint32_t offset = (sequence - expected) & sequenceMask;
+        if (offset >= slotCount) {
+            advance(offset - static_cast<std::uint32_t>(slotCount) + 1, release);
+        }
+        const std::uint32_t slot = (sequence - expected) & sequenceMask;
+        if (pending & (1ull << slot)) {
+            bump(duplicates);
+        }
+        else {
+            if ((pending >> slot) != 0) {
+                bump(reordered);
+            }
+            if (slot == 0) {
+                // Next in line: straight through from the caller's buffer, no copy
+                release(data, size, tag, now);
+                pending >>= 1;
+                history = (history << 1) | 1u;
+                expected = (expected + 1) & sequenceMask;
+                releaseFront(release);
+            }
+            else if (!store(slot, data, size, tag, now)) {
+                bump(oversize);
+            }
+        }
+        updateHeld();
+        maybePostStats(now);
+    }
+
+    template <typename Handler>
+    void SequenceTracker::expire(std::int64_t now, Handler&& release) {
+        while (pending != 0) {
+            std::int64_t oldest = now;
+            for (std::uint64_t bits = pending; bits != 0; bits &= bits - 1) {
+                const std::uint32_t offset = static_cast<std::uint32_t>(lowestBit(bits));
+                const std::int64_t arrival = slots[(expected + offset) & slotMask].arrival;
+                oldest = arrival < oldest ? arrival : oldest;
+            }
+            if (now - oldest <= maxHold) {
+                break;
+            }
+            advance(static_cast<std::uint32_t>(lowestBit(pending)), release);
+        }
+        updateHeld();
+    }
+
+    template <typename Handler>
+    void SequenceTracker::tick(std::int64_t now, Handler&& release) {
+        expire(now, release);
+        maybePostStats(now);
+    }
+
+    template <typename Handler>
+    void SequenceTracker::flush(Handler&& release) {
+        while (pending != 0) {
+            advance(static_cast<std::uint32_t>(lowestBit(pending)), release);
+        }
+        updateHeld();
+    }
+
+} // namespace SkyLine
+
+#endif // SKYLINE_SEQUENCETRACKER_H
@@ -0,0 +1,153 @@
+// Serial receiver on a pseudo-terminal (Linux): MAVLink frames written into
+// the pty master must come out of the slave in order through the epoll
+// thread, a stop()/start() cycle must leave an idle receiver asleep instead
+// of spinning, and closing the master must be counted as one hang-up that
+// ends the thread, so isRunning() turns false without a stop() and stop()
+// still returns at once.
+#ifdef __linux__
+
+#include "Bench.h"
+#include "MavlinkParser.h"
+#include "SerialReceiver.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::uint32_t FramesPerBurst = 2000;
+        const auto Idle = std::chrono::milliseconds(200);
+        const auto Patience = std::chrono::seconds(5);
+
+        // Counts ATTITUDE frames and checks that time_boot_ms keeps counting up by one
+        struct Receiving {
+            MavlinkParser parser;
+            std::atomic<std::uint32_t> frames{ 0 };
+            std::uint32_t outOfOrder = 0;
+
+            void feed(const std::uint8_t* data, std::size_t size) {
+                parser.parse(data, size, [this](const MavlinkMessage& message) {
+                    const std::uint32_t count = frames.load(std::memory_order_relaxed);
+                    if (message.field<std::uint32_t>(0) != count) {
+                        ++outOfOrder;
+                    }
+                    frames.store(count + 1, std::memory_order_release);
+                });
+            }
+        };
+
+        bool writeAll(int fd, const std::uint8_t* data, std::size_t size) {
+            while (size > 0) {
+                const ssize_t written = ::write(fd, data, size);
+                if (written <= 0) {
+                    return false;
+                }
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+            return true;
+        }
+
+        // Frames first..first+FramesPerBurst-1, written in 256-byte pieces that split frames
+        bool writeBurst(int master, std::uint32_t first) {
+            std::vector<std::uint8_t> burst;
+            for (std::uint32_t n = first; n < first + FramesPerBurst; ++n) {
+                const std::vector<std::uint8_t> frame = attitudeFrame(static_cast<std::uint8_t>(n), n, 0.0f);
+                burst.insert(burst.end(), frame.begin(), frame.end());
+            }
+            for (std::size_t offset = 0; offset < burst.size(); offset += 256) {
+                const std::size_t size = burst.size() - offset < 256 ? burst.size() - offset : 256;
+                if (!writeAll(master, burst.data() + offset, size)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename Condition>
+        bool waitFor(Condition&& condition) {
+            const auto deadline = std::chrono::steady_clock::now() + Patience;
+            while (!condition()) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return true;
+        }
+
+        // Wakeups of an idle receiver over Idle; a spinning thread racks up thousands
+        std::uint64_t idleWakeups(const SerialReceiver& serial) {
+            const std::uint64_t before = serial.wakeups();
+            std::this_thread::sleep_for(Idle);
+            return serial.wakeups() - before;
+        }
+
+    } // namespace
+
+    bool benchSerialPty() {
+        const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+            std::printf("no pseudo-terminal available\n");
+            if (master >= 0) {
+                ::close(master);
+            }
+            return false;
+        }
+        const std::string slave = ::ptsname(master);
+
+        Receiving receiving;
+        SerialReceiver serial;
+        serial.setDataHandler([&receiving](const std::uint8_t* data, std::size_t size) {
+            receiving.feed(data, size);
+        });
+        if (!serial.open(slave, 115200)) {
+            ::close(master);
+            return false;
+        }
+        serial.start();
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool firstBurst = writeBurst(master, 0) &&
+            waitFor([&receiving]() { return receiving.frames.load(std::memory_order_acquire) == FramesPerBurst; });
+        const double seconds = secondsSince(start);
+        const std::uint64_t burstWakeups = serial.wakeups();
+
+        serial.stop();
+        serial.start();
+        const std::uint64_t restartedIdle = idleWakeups(serial);
+        const bool secondBurst = writeBurst(master, FramesPerBurst) &&
+            waitFor([&receiving]() { return receiving.frames.load(std::memory_order_acquire) == 2 * FramesPerBurst; });
+
+        ::close(master);
+        const bool hungUp = waitFor([&serial]() { return serial.hangUps() > 0; });
+        const bool endedItself = waitFor([&serial]() { return !serial.isRunning(); });
+        const std::uint64_t hungUpIdle = idleWakeups(serial);
+        const auto stopStart = std::chrono::steady_clock::now();
+        serial.stop();
+        const double stopSeconds = secondsSince(stopStart);
+        serial.close();
+
+        const bool inOrder = firstBurst && secondBurst && receiving.outOfOrder == 0 &&
+            receiving.parser.crcErrors() == 0 && serial.readErrors() == 0;
+        const bool quiet = restartedIdle <= 1 && hungUpIdle <= 1 && stopSeconds < 1.0;
+
+        std::printf("%u frames in %.1f ms, %llu wakeups, %llu reads; in order: %s\n", FramesPerBurst, seconds * 1e3,
+            static_cast<unsigned long long>(burstWakeups), static_cast<unsigned long long>(serial.readCalls()),
+            inOrder ? "yes" : "no");
+        std::printf("idle wakeups after restart %llu, after hang-up %llu; hang-ups %llu, thread ended: %s; "
+            "stop took %.1f ms\n", static_cast<unsigned long long>(restartedIdle),
+            static_cast<unsigned long long>(hungUpIdle), static_cast<unsigned long long>(serial.hangUps()),
+            endedItself ? "yes" : "no", stopSeconds * 1e3);
+        return inOrder && quiet && hungUp && endedItself && serial.hangUps() == 1;
+    }
+
+} // namespace SkyLine
+
+#endif // __linux__
@@ -0,0 +1,421 @@
+#include "SerialReceiver.h"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+namespace SkyLink {
+
+    namespace {
+        const std::intptr_t InvalidHandle = -1;
+        const std::size_t RingMask = SerialReceiver::RingBytes - 1;
+        static_assert((SerialReceiver::RingBytes & RingMask) == 0, "RingBytes must be a power of two");
+#ifdef _WIN32
+        const int ErrorBackoffMilliseconds = 100; // between retries after a failed read
+#endif
+
+#ifndef _WIN32
+        bool speedFor(unsigned baudRate, speed_t& speed) {
+            switch (baudRate) {
+            case 9600: speed = B9600; return true;
+            case 19200: speed = B19200; return true;
+            case 38400: speed = B38400; return true;
+            case 57600: speed = B57600; return true;
+            case 115200: speed = B115200; return true;
+            case 230400: speed = B230400; return true;
+#ifdef B460800
+            case 460800: speed = B460800; return true;
+#endif
+#ifdef B921600
+            case 921600: speed = B921600; return true;
+#endif
+            default: return false;
+            }
+        }
+#endif
+    }
+
+    SerialReceiver::SerialReceiver()
+        : deviceHandle(InvalidHandle), wakeHandle(InvalidHandle), running(false), head(0), tail(0),
+        bytes(0), reads(0), wakes(0), errors(0), hangups(0) {
+        ring.resize(RingBytes);
+    }
+
+    SerialReceiver::~SerialReceiver() {
+        stop();
+        close();
+    }
+
+    void SerialReceiver::setDataHandler(DataHandler newHandler) {
+        handler = newHandler;
+    }
+
+    void SerialReceiver::setTickHandler(TickHandler newHandler) {
+        tickHandler = newHandler;
+    }
+
+    void SerialReceiver::start() {
+        if (running.load() || deviceHandle == InvalidHandle) {
+            return;
+        }
+        if (worker.joinable()) {
+            worker.join(); // ended on its own after a hang-up
+        }
+        running.store(true, std::memory_order_release);
+        worker = std::thread(&SerialReceiver::run, this);
+    }
+
+    void SerialReceiver::dispatch() {
+        while (head != tail) {
+            const std::size_t slot = head & RingMask;
+            std::size_t run = RingBytes - slot;
+            run = run < tail - head ? run : tail - head;
+            if (handler) {
+                handler(ring.data() + slot, run);
+            }
+            head += run;
+        }
+    }
+
+    void SerialReceiver::tickIfDue(std::chrono::steady_clock::time_point& due) {
+        if (!tickHandler) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= due) {
+            tickHandler();
+            due = now + std::chrono::milliseconds(TickMilliseconds);
+        }
+    }
+
+#ifdef _WIN32
+
+    bool SerialReceiver::open(const std::string& device, unsigned baudRate) {
+        close();
+        const std::string path = device.compare(0, 4, "\\\\.\\") == 0 ? device : "\\\\.\\" + device;
+        HANDLE port = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+        if (port == INVALID_HANDLE_VALUE) {
+            std::cerr << "ERROR::SERIALRECEIVER::Could not open " << device << std::endl;
+            return false;
+        }
+        DCB settings;
+        SecureZeroMemory(&settings, sizeof(settings));
+        settings.DCBlength = sizeof(settings);
+        GetCommState(port, &settings);
+        settings.BaudRate = baudRate;
+        settings.ByteSize = 8;
+        settings.Parity = NOPARITY;
+        settings.StopBits = ONESTOPBIT;
+        settings.fBinary = TRUE;
+        settings.fOutxCtsFlow = FALSE;
+        settings.fRtsControl = RTS_CONTROL_ENABLE;
+        settings.fDtrControl = DTR_CONTROL_ENABLE;
+        if (!SetCommState(port, &settings)) {
+            std::cerr << "ERROR::SERIALRECEIVER::Could not configure " << device << std::endl;
+            CloseHandle(port);
+            return false;
+        }
+        // Return as soon as anything is buffered, otherwise wait up to 100 ms for the first byte
+        COMMTIMEOUTS timeouts;
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = 100;
+        timeouts.WriteTotalTimeoutMultiplier = 0;
+        timeouts.WriteTotalTimeoutConstant = 0;
+        SetCommTimeouts(port, &timeouts);
+        SetupComm(port, static_cast<DWORD>(RingBytes), 4096);
+        deviceHandle = reinterpret_cast<std::intptr_t>(port);
+        head = tail = 0;
+        return true;
+    }
+
+    void SerialReceiver::close() {
+        if (deviceHandle != InvalidHandle) {
+            CloseHandle(reinterpret_cast<HANDLE>(deviceHandle));
+            deviceHandle = InvalidHandle;
+        }
+    }
+
+    void SerialReceiver::stop() {
+        running.store(false, std::memory_order_release);
+        if (worker.joinable()) {
+            worker.join(); // the read timeout bounds how long this takes
+        }
+    }
+
+    std::size_t SerialReceiver::fill() {
+        std::size_t total = 0;
+        while (tail - head < RingBytes) {
+            const std::size_t slot = tail & RingMask;
+            std::size_t space = RingBytes - slot;
+            space = space < RingBytes - (tail - head) ? space : RingBytes - (tail - head);
+            space = space < ReadBytes ? space : ReadBytes;
+            DWORD length = 0;
+            const BOOL ok = ReadFile(reinterpret_cast<HANDLE>(deviceHandle), ring.data() + slot, static_cast<DWORD>(space), &length, nullptr);
+            reads.fetch_add(1, std::memory_order_relaxed);
+            if (!ok) {
+                errors.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            tail += length;
+            total += length;
+            if (length < space) {
+                break; // driver buffer drained
+            }
+        }
+        return total;
+    }
+
+    void SerialReceiver::run() {
+        if (tickHandler) {
+            // A quiet port must still return from ReadFile in time for the tick
+            COMMTIMEOUTS timeouts;
+            GetCommTimeouts(reinterpret_cast<HANDLE>(deviceHandle), &timeouts);
+            timeouts.ReadTotalTimeoutConstant = TickMilliseconds;
+            SetCommTimeouts(reinterpret_cast<HANDLE>(deviceHandle), &timeouts);
+        }
+        const HANDLE port = reinterpret_cast<HANDLE>(deviceHandle);
+        auto nextTick = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_acquire)) {
+            const std::uint64_t failedBefore = errors.load(std::memory_order_relaxed);
+            const std::size_t received = fill();
+            tickIfDue(nextTick);
+            if (received > 0) {
+                wakes.fetch_add(1, std::memory_order_relaxed);
+                bytes.fetch_add(received, std::memory_order_relaxed);
+                dispatch();
+            }
+            if (errors.load(std::memory_order_relaxed) == failedBefore) {
+                continue;
+            }
+            // A failed ReadFile returns at once, so retrying straight away would spin
+            DWORD lineErrors = 0;
+            if (!ClearCommError(port, &lineErrors, nullptr)) {
+                // The port itself is gone (USB radio unplugged)
+                std::cerr << "ERROR::SERIALRECEIVER::Device hung up" << std::endl;
+                hangups.fetch_add(1, std::memory_order_relaxed);
+                running.store(false, std::memory_order_release);
+                break;
+            }
+            // A line error (framing, overrun) is cleared; back off in case it persists
+            std::this_thread::sleep_for(std::chrono::milliseconds(ErrorBackoffMilliseconds));
+        }
+    }
+
+#else
+
+    bool SerialReceiver::open(const std::string& device, unsigned baudRate) {
+        close();
+        speed_t speed;
+        if (!speedFor(baudRate, speed)) {
+            std::cerr << "ERROR::SERIALRECEIVER::Unsupported baud rate " << baudRate << std::endl;
+            return false;
+        }
+        int fd = ::open(device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "ERROR::SERIALRECEIVER::Could not open " << device << std::endl;
+            return false;
+        }
+        // Raw 8N1: no line discipline, no echo, no flow control, no translation
+        termios settings;
+        if (::tcgetattr(fd, &settings) != 0) {
+            std::cerr << "ERROR::SERIALRECEIVER::" << device << " is not a tty" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        ::cfmakeraw(&settings);
+        settings.c_cflag |= CLOCAL | CREAD;
+        settings.c_cflag &= ~CSTOPB;
+#ifdef CRTSCTS
+        settings.c_cflag &= ~CRTSCTS;
+#endif
+        settings.c_cc[VMIN] = 0;
+        settings.c_cc[VTIME] = 0;
+        ::cfsetispeed(&settings, speed);
+        ::cfsetospeed(&settings, speed);
+        if (::tcsetattr(fd, TCSANOW, &settings) != 0) {
+            std::cerr << "ERROR::SERIALRECEIVER::Could not configure " << device << std::endl;
+            ::close(fd);
+            return false;
+        }
+        ::tcflush(fd, TCIFLUSH);
+
+#ifdef __linux__
+        const int wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wake < 0) {
+            std::cerr << "ERROR::SERIALRECEIVER::Could not create eventfd" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        wakeHandle = wake;
+#endif
+        deviceHandle = fd;
+        head = tail = 0;
+        return true;
+    }
+
+    void SerialReceiver::close() {
+        if (deviceHandle != InvalidHandle) {
+            ::close(static_cast<int>(deviceHandle));
+            deviceHandle = InvalidHandle;
+        }
+        if (wakeHandle != InvalidHandle) {
+            ::close(static_cast<int>(wakeHandle));
+            wakeHandle = InvalidHandle;
+        }
+    }
+
+    void SerialReceiver::stop() {
+        running.store(false, std::memory_order_release);
+        if (wakeHandle != InvalidHandle) {
+            const std::uint64_t one = 1;
+            const ssize_t written = ::write(static_cast<int>(wakeHandle), &one, sizeof(one));
+            (void)written;
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    std::size_t SerialReceiver::fill() {
+        const int fd = static_cast<int>(deviceHandle);
+        std::size_t total = 0;
+        while (tail - head < RingBytes) {
+            const std::size_t slot = tail & RingMask;
+            std::size_t space = RingBytes - slot;
+            space = space < RingBytes - (tail - head) ? space : RingBytes - (tail - head);
+            space = space < ReadBytes ? space : ReadBytes;
+            const ssize_t length = ::read(fd, ring.data() + slot, space);
+            reads.fetch_add(1, std::memory_order_relaxed);
+            if (length > 0) {
+                tail += static_cast<std::size_t>(length);
+                total += static_cast<std::size_t>(length);
+                if (static_cast<std::size_t>(length) < space) {
+                    break; // kernel buffer drained, no need for the EAGAIN round trip
+                }
+                continue;
+            }
+            if (length < 0 && errno == EINTR) {
+                continue;
+            }
+            // EIO: the other end hung up, run() counts that from the poll result
+            if (length < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EIO) {
+                errors.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+        return total;
+    }
+
+#ifdef __linux__
+
+    void SerialReceiver::run() {
+        const int fd = static_cast<int>(deviceHandle);
+        const int wake = static_cast<int>(wakeHandle);
+        const int poller = ::epoll_create1(EPOLL_CLOEXEC);
+        if (poller < 0) {
+            std::cerr << "ERROR::SERIALRECEIVER::Could not create epoll instance" << std::endl;
+            return;
+        }
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event);
+        event.events = EPOLLIN;
+        event.data.fd = wake;
+        ::epoll_ctl(poller, EPOLL_CTL_ADD, wake, &event);
+
+        // Without a tick handler there is nothing to do until bytes arrive or stop() pokes the eventfd
+        const int timeout = tickHandler ? TickMilliseconds : -1;
+        auto nextTick = std::chrono::steady_clock::now();
+        epoll_event ready[2];
+        while (running.load(std::memory_order_acquire)) {
+            const int count = ::epoll_wait(poller, ready, 2, timeout);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                errors.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            tickIfDue(nextTick);
+            if (count == 0) {
+                continue; // tick timeout, not a wakeup
+            }
+            wakes.fetch_add(1, std::memory_order_relaxed);
+            for (int i = 0; i < count; ++i) {
+                if (ready[i].data.fd != fd) {
+                    std::uint64_t value;
+                    const ssize_t drained = ::read(wake, &value, sizeof(value)); // stop() poked the eventfd
+                    (void)drained;
+                    continue;
+                }
+                const std::size_t received = fill();
+                if (received > 0) {
+                    bytes.fetch_add(received, std::memory_order_relaxed);
+                    dispatch();
+                }
+                if ((ready[i].events & (EPOLLHUP | EPOLLERR)) && received == 0) {
+                    // Device unplugged or the other end of the pty closed: nothing more
+                    // will arrive, so the thread ends and isRunning() tells the owner
+                    std::cerr << "ERROR::SERIALRECEIVER::Device hung up" << std::endl;
+                    hangups.fetch_add(1, std::memory_order_relaxed);
+                    running.store(false, std::memory_order_release);
+                    break;
+                }
+            }
+        }
+        ::close(poller);
+    }
+
+#else
+
+    void SerialReceiver::run() {
+        // No epoll here: poll with a short timeout so stop() is noticed
+        pollfd watch;
+        watch.fd = static_cast<int>(deviceHandle);
+        watch.events = POLLIN;
+        const int timeout = tickHandler ? TickMilliseconds : 100;
+        auto nextTick = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_acquire)) {
+            watch.revents = 0;
+            const int count = ::poll(&watch, 1, timeout);
+            tickIfDue(nextTick);
+            if (count <= 0) {
+                continue;
+            }
+            wakes.fetch_add(1, std::memory_order_relaxed);
+            const std::size_t received = fill();
+            if (received > 0) {
+                bytes.fetch_add(received, std::memory_order_relaxed);
+                dispatch();
+            }
+            else if (watch.revents & (POLLHUP | POLLERR)) {
+                std::cerr << "ERROR::SERIALRECEIVER::Device hung up" << std::endl;
+                hangups.fetch_add(1, std::memory_order_relaxed);
+                running.store(false, std::memory_order_release);
+                break;
+            }
+        }
+    }
+
+#endif
+
+#endif
+
+} // namespace SkyLine
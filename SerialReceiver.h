@@ -0,0 +1,82 @@
+#ifndef SKYLINE_SERIALRECEIVER_H
+#define SKYLINE_SERIALRECEIVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    // Serial (USB radio) telemetry source. A dedicated thread opens the tty in
+    // raw non-blocking mode, sleeps in epoll until bytes arrive, then reads as
+    // much as is available in large chunks into a ring buffer and hands the
+    // filled region to the data handler (typically MavlinkDecoder::feed).
+    // On Windows the COM port is read with a timeout instead of epoll. A device
+    // that goes away ends the thread; failed reads on a live port back off.
+    class SerialReceiver {
+    public:
+        typedef std::function<void(const std::uint8_t* data, std::size_t size)> DataHandler;
+        typedef std::function<void()> TickHandler;
+
+        static const std::size_t RingBytes = 64 * 1024;
+        static const std::size_t ReadBytes = 16 * 1024; // largest single read
+        static const int TickMilliseconds = 10;         // tick period, and the wait timeout while ticking
+
+        SerialReceiver();
+        ~SerialReceiver();
+
+        SerialReceiver(const SerialReceiver&) = delete;
+        SerialReceiver& operator=(const SerialReceiver&) = delete;
+
+        // device: /dev/ttyUSB0, a pty slave, or COM3 on Windows
+        bool open(const std::string& device, unsigned baudRate = 57600);
+        void close();
+
+        void setDataHandler(DataHandler handler);
+        // Called on the receive thread every TickMilliseconds or so, also while the
+        // device is quiet (MavlinkDecoder::tick). Set it before start().
+        void setTickHandler(TickHandler handler);
+
+        void start();
+        void stop();
+        // Turns false by itself once the device hangs up (unplugged, pty master closed)
+        bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+        std::uint64_t bytesReceived() const { return bytes.load(std::memory_order_relaxed); }
+        std::uint64_t readCalls() const { return reads.load(std::memory_order_relaxed); }
+        std::uint64_t wakeups() const { return wakes.load(std::memory_order_relaxed); }
+        std::uint64_t readErrors() const { return errors.load(std::memory_order_relaxed); }
+        std::uint64_t hangUps() const { return hangups.load(std::memory_order_relaxed); } // device unplugged, pty master closed
+
+    private:
+        void run();
+        std::size_t fill();       // reads until the device is empty or the ring is full
+        void dispatch();          // hands everything buffered to the handler
+        void tickIfDue(std::chrono::steady_clock::time_point& due);
+
+        DataHandler handler;
+        TickHandler tickHandler;
+        std::intptr_t deviceHandle;
+        std::intptr_t wakeHandle; // eventfd that interrupts the wait on stop()
+        std::thread worker;
+        std::atomic<bool> running;
+
+        std::vector<std::uint8_t> ring;
+        std::size_t head; // next byte to dispatch
+        std::size_t tail; // next byte to fill; head == tail is empty
+
+        std::atomic<std::uint64_t> bytes;
+        std::atomic<std::uint64_t> reads;
+        std::atomic<std::uint64_t> wakes;
+        std::atomic<std::uint64_t> errors;
+        std::atomic<std::uint64_t> hangups;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_SERIALRECEIVER_H
@@ -0,0 +1,200 @@
+#include "SharedMemory.h"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SkyLink {
+
+#ifdef _WIN32
+
+    namespace {
+        // Session-local namespace, no privilege needed
+        std::string mappingName(const std::string& name) {
+            return "Local\\" + (name.empty() || name[0] != '/' ? name : name.substr(1));
+        }
+    }
+
+    SharedMemory::SharedMemory() : view(nullptr), length(0), owner(false), mappingHandle(nullptr) {}
+
+    bool SharedMemory::create(const std::string& name, std::size_t size) {
+        close();
+        const std::uint64_t size64 = size;
+        HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu), mappingName(name).c_str());
+        if (!mapping) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not create " << name << std::endl;
+            return false;
+        }
+        if (GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(mapping); // someone else's mapping, opened rather than created
+            return false;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!view) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not map " << name << std::endl;
+            CloseHandle(mapping);
+            return false;
+        }
+        mappingHandle = mapping;
+        length = size;
+        segmentName = name;
+        owner = true;
+        return true;
+    }
+
+    bool SharedMemory::remove(const std::string&) {
+        return false;
+    }
+
+    bool SharedMemory::openReadOnly(const std::string& name) {
+        close();
+        HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName(name).c_str());
+        if (!mapping) {
+            return false;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not map " << name << std::endl;
+            CloseHandle(mapping);
+            return false;
+        }
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(view, &info, sizeof(info));
+        mappingHandle = mapping;
+        length = info.RegionSize;
+        segmentName = name;
+        owner = false;
+        return true;
+    }
+
+    void SharedMemory::close() {
+        if (view) {
+            UnmapViewOfFile(view);
+            view = nullptr;
+        }
+        if (mappingHandle) {
+            CloseHandle(mappingHandle); // the mapping disappears with its last handle
+            mappingHandle = nullptr;
+        }
+        length = 0;
+        owner = false;
+    }
+
+#else
+
+    SharedMemory::SharedMemory() : view(nullptr), length(0), owner(false), fileDescriptor(-1), device(0), inode(0) {}
+
+    bool SharedMemory::create(const std::string& name, std::size_t size) {
+        close();
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0) {
+            if (errno != EEXIST) {
+                std::cerr << "ERROR::SHAREDMEMORY::Could not create " << name << std::endl;
+            }
+            return false;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not stat " << name << std::endl;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not size " << name << std::endl;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+        void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not map " << name << std::endl;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+        fileDescriptor = fd;
+        device = static_cast<std::uint64_t>(info.st_dev);
+        inode = static_cast<std::uint64_t>(info.st_ino);
+        view = mapped;
+        length = size;
+        segmentName = name;
+        owner = true;
+        return true;
+    }
+
+    bool SharedMemory::remove(const std::string& name) {
+        // Readers still attached to the old segment keep it; new ones find the next create()
+        return ::shm_unlink(name.c_str()) == 0;
+    }
+
+    bool SharedMemory::openReadOnly(const std::string& name) {
+        close();
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "ERROR::SHAREDMEMORY::Could not map " << name << std::endl;
+            ::close(fd);
+            return false;
+        }
+        fileDescriptor = fd;
+        view = mapped;
+        length = size;
+        segmentName = name;
+        owner = false;
+        return true;
+    }
+
+    void SharedMemory::close() {
+        if (view) {
+            ::munmap(view, length);
+            view = nullptr;
+        }
+        if (fileDescriptor >= 0) {
+            ::close(fileDescriptor);
+            fileDescriptor = -1;
+        }
+        if (owner) {
+            // Only while the name still refers to our segment, not to a successor's
+            const int current = ::shm_open(segmentName.c_str(), O_RDONLY, 0);
+            if (current >= 0) {
+                struct stat info;
+                const bool ours = ::fstat(current, &info) == 0 &&
+                    static_cast<std::uint64_t>(info.st_dev) == device && static_cast<std::uint64_t>(info.st_ino) == inode;
+                ::close(current);
+                if (ours) {
+                    ::shm_unlink(segmentName.c_str());
+                }
+            }
+            owner = false;
+        }
+        length = 0;
+    }
+
+#endif
+
+    SharedMemory::~SharedMemory() {
+        close();
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,53 @@
+#ifndef SKYLINE_SHAREDMEMORY_H
+#define SKYLINE_SHAREDMEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SkyLink {
+
+    // Named shared memory segment, POSIX shm_open or a Win32 named mapping underneath.
+    // The creator owns the name and removes it again on close, unless the name
+    // has meanwhile been removed and given to another segment.
+    class SharedMemory {
+    public:
+        SharedMemory();
+        ~SharedMemory();
+
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+        // Creates the segment, zero-filled, mapped read/write. Fails quietly if the
+        // name is taken: the caller decides whether to remove() it and retry.
+        bool create(const std::string& name, std::size_t size);
+        // Removes a name so create() can reuse it; mapped views stay valid. Always
+        // false on Windows, where a mapping lives until its last handle closes.
+        static bool remove(const std::string& name);
+        // Maps an existing segment read-only
+        bool openReadOnly(const std::string& name);
+        void close();
+
+        bool isOpen() const { return view != nullptr; }
+        std::uint8_t* data() { return static_cast<std::uint8_t*>(view); }
+        const std::uint8_t* data() const { return static_cast<const std::uint8_t*>(view); }
+        std::size_t size() const { return length; }
+        const std::string& name() const { return segmentName; }
+
+    private:
+        void* view;
+        std::size_t length;
+        std::string segmentName;
+        bool owner;
+#ifdef _WIN32
+        void* mappingHandle;
+#else
+        int fileDescriptor;
+        std::uint64_t device; // identity of the created segment, checked before unlinking
+        std::uint64_t inode;
+#endif
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_SHAREDMEMORY_H
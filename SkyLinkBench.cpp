@@ -0,0 +1,114 @@
+// Micro-benchmarks and self-checks for the data path. Each case lives next to
+// the code it measures (CellLabelBench.cpp, ...) and is listed below.
+//
+//   SkyLinkBench [case...]   runs every case when none is named
+#include "Bench.h"
+#include "MavlinkParser.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+    std::atomic<std::uint64_t> allocations(0);
+
+    struct Case {
+        const char* name;
+        bool (*run)();
+    };
+
+    const Case cases[] = {
+        { "label", SkyLink::benchCellLabel },
+        { "udp", SkyLink::benchUdpLoopback },
+        { "recorder", SkyLink::benchRecording },
+        { "parser", SkyLink::benchMavlinkParser },
+        { "ccsds", SkyLink::benchCcsds },
+        { "calibration", SkyLink::benchCalibration },
+        { "alarm", SkyLink::benchAlarmDisplay },
+        { "sequence", SkyLink::benchSequenceTracking },
+        { "bus", SkyLink::benchTelemetryBus },
+        { "gorilla", SkyLink::benchGorilla },
+        { "archive", SkyLink::benchArchive },
+        { "query", SkyLink::benchArchiveQuery },
+        { "merger", SkyLink::benchTimestampMerger },
+        { "replay", SkyLink::benchReplay },
+        { "stats", SkyLink::benchRollingStats },
+        { "queue", SkyLink::benchQueuedObserver },
+#ifdef __linux__
+        { "serial", SkyLink::benchSerialPty },
+#endif
+    };
+
+} // namespace
+
+// Counted global allocator, so cases can assert that a path never touches the heap
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace SkyLink {
+
+    std::uint64_t allocationCount() {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    std::vector<std::uint8_t> attitudeFrame(std::uint8_t sequence, std::uint32_t timeBootMs, float roll) {
+        const std::uint8_t attitudeCrcExtra = 39;
+        std::vector<std::uint8_t> frame = { MavlinkParser::StxV1, 28, sequence, 1, 1, 30 };
+        frame.resize(frame.size() + 28, 0);
+        std::memcpy(frame.data() + 6, &timeBootMs, sizeof(timeBootMs));
+        std::memcpy(frame.data() + 6 + 4, &roll, sizeof(roll));
+        const std::uint16_t crc = mavlinkCrcAccumulate(attitudeCrcExtra, mavlinkCrc(frame.data() + 1, frame.size() - 1));
+        frame.push_back(static_cast<std::uint8_t>(crc));
+        frame.push_back(static_cast<std::uint8_t>(crc >> 8));
+        return frame;
+    }
+
+} // namespace SkyLine
+
+int main(int argc, char** argv) {
+    int ran = 0;
+    int failed = 0;
+    for (const Case& test : cases) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], test.name) == 0) {
+                selected = true;
+            }
+        }
+        if (!selected) {
+            continue;
+        }
+        std::printf("== %s\n", test.name);
+        const bool ok = test.run();
+        std::printf("%s %s\n", ok ? "PASS" : "FAIL", test.name);
+        std::fflush(stdout);
+        ++ran;
+        if (!ok) {
+            ++failed;
+        }
+    }
+    if (ran == 0) {
+        std::printf("usage: SkyLinkBench [case...], cases:");
+        for (const Case& test : cases) {
+            std::printf(" %s", test.name);
+        }
+        std::printf("\n");
+        return 2;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,330 @@
+// Headless ingest daemon: the same receive -> decode -> record pipeline as the
+// GUI, without GL, ImGui or FreeType, for ground-station servers.
+//
+//   SkyLinkDaemon [--port 14550 | --serial /dev/ttyUSB0 [--baud 57600] | --generate 1000 [--rate 100]]
+//                 [--record path] [--raw] [--bus] [--channels 64] [--stats 5]
+//   SkyLinkDaemon --bus-read [--stats 5]   follow the telemetry bus of another daemon
+#include "DataProvider.h"
+#include "FlightRecorder.h"
+#include "LoadGenerator.h"
+#include "MavlinkDecoder.h"
+#include "SerialReceiver.h"
+#include "TelemetryBus.h"
+#include "UdpReceiver.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SkyLink;
+
+namespace {
+
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void onSignal(int) {
+        stopRequested = 1;
+    }
+
+    struct Options {
+        std::uint16_t port = 14550;
+        std::string serialDevice; // empty: UDP
+        unsigned baudRate = 57600;
+        std::size_t generateChannels = 0; // > 0: synthetic load instead of a link
+        double generateRate = 100.0;
+        std::string recordPath = "flight";
+        bool record = true;
+        bool gorilla = true;
+        bool bus = false;
+        bool busRead = false;
+        ChannelId channels = 64;
+        int statsSeconds = 5;
+    };
+
+    void usage() {
+        std::cout << "usage: SkyLinkDaemon [--port N | --serial device [--baud N] | --generate channels [--rate hz]]"
+            " [--record path | --no-record] [--raw] [--bus]"
+            " [--channels N] [--stats seconds]" << std::endl;
+        std::cout << "       SkyLinkDaemon --bus-read [--stats seconds]" << std::endl;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--port" && hasValue) {
+                options.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--serial" && hasValue) {
+                options.serialDevice = argv[++i];
+            }
+            else if (arg == "--baud" && hasValue) {
+                options.baudRate = static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--generate" && hasValue) {
+                options.generateChannels = static_cast<std::size_t>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--rate" && hasValue) {
+                options.generateRate = std::atof(argv[++i]);
+            }
+            else if (arg == "--record" && hasValue) {
+                options.recordPath = argv[++i];
+                options.record = true;
+            }
+            else if (arg == "--no-record") {
+                options.record = false;
+            }
+            else if (arg == "--raw") {
+                options.gorilla = false;
+            }
+            else if (arg == "--bus") {
+                options.bus = true;
+            }
+            else if (arg == "--bus-read") {
+                options.busRead = true;
+            }
+            else if (arg == "--channels" && hasValue) {
+                options.channels = static_cast<ChannelId>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--stats" && hasValue) {
+                options.statsSeconds = std::atoi(argv[++i]);
+            }
+            else {
+                usage();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // One line per interval: rates since the last line, totals where rates make no sense
+    class StatsPrinter {
+    public:
+        StatsPrinter(const MavlinkDecoder& decoder, const DataProvider& provider,
+            const FlightRecorder* recorder, const QueuedObserver* recorderQueue)
+            : decoder(decoder), provider(provider), recorder(recorder), recorderQueue(recorderQueue),
+            lastTime(std::chrono::steady_clock::now()), lastMessages(0), lastSamples(0), lastBytes(0),
+            frames(0), frameTotal(0.0), frameMax(0.0) {}
+
+        void addFrame(double milliseconds) {
+            ++frames;
+            frameTotal += milliseconds;
+            if (milliseconds > frameMax) {
+                frameMax = milliseconds;
+            }
+        }
+
+        void print() {
+            const auto now = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - lastTime).count();
+            lastTime = now;
+
+            const std::uint64_t messages = decoder.parser().messagesParsed();
+            const std::uint64_t samples = provider.ingestQueue().pushCount();
+            const std::uint64_t bytes = recorder ? recorder->bytesWritten() : 0;
+
+            std::uint64_t gaps = 0;
+            std::uint64_t duplicates = 0;
+            for (std::size_t i = 0; i < decoder.linkCount(); ++i) {
+                gaps += decoder.link(i).gapCount();
+                duplicates += decoder.link(i).duplicateCount();
+            }
+
+            std::printf("msg/s %.0f  samples/s %.0f  frame ms %.3f/%.3f  crc %llu  gaps %llu  dup %llu  queue hw %zu drop %llu",
+                (messages - lastMessages) / seconds, (samples - lastSamples) / seconds,
+                frames ? frameTotal / frames : 0.0, frameMax,
+                static_cast<unsigned long long>(decoder.parser().crcErrors()),
+                static_cast<unsigned long long>(gaps), static_cast<unsigned long long>(duplicates),
+                provider.ingestQueue().highWaterMark(),
+                static_cast<unsigned long long>(provider.ingestQueue().dropCount()));
+            if (recorder) {
+                std::printf("  rec kB/s %.1f  rec drop %llu",
+                    (bytes - lastBytes) / seconds / 1024.0,
+                    static_cast<unsigned long long>(recorder->droppedSamples() + (recorderQueue ? recorderQueue->dropCount() : 0)));
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+
+            lastMessages = messages;
+            lastSamples = samples;
+            lastBytes = bytes;
+            frames = 0;
+            frameTotal = 0.0;
+            frameMax = 0.0;
+        }
+
+    private:
+        const MavlinkDecoder& decoder;
+        const DataProvider& provider;
+        const FlightRecorder* recorder;
+        const QueuedObserver* recorderQueue;
+        std::chrono::steady_clock::time_point lastTime;
+        std::uint64_t lastMessages;
+        std::uint64_t lastSamples;
+        std::uint64_t lastBytes;
+        std::uint64_t frames;
+        double frameTotal;
+        double frameMax;
+    };
+
+    // Minimal bus client: reads every sample another daemon publishes and
+    // prints the rate, the samples lost to lapping and channel 0's latest value
+    int readBus(const Options& options) {
+        TelemetryBusReader bus;
+        if (!bus.open(DefaultBusName)) {
+            return 1;
+        }
+        std::cout << "SkyLinkDaemon: reading telemetry bus " << DefaultBusName << ", "
+            << bus.channelCount() << " channels" << std::endl;
+
+        std::vector<Sample> samples(4096);
+        const auto idleInterval = std::chrono::milliseconds(10);
+        const auto statsInterval = std::chrono::seconds(options.statsSeconds > 0 ? options.statsSeconds : 1);
+        const std::int64_t quietTimeout = 2ll * 1000 * 1000 * 1000;
+        auto lastStats = std::chrono::steady_clock::now();
+        std::uint64_t received = 0;
+        while (!stopRequested) {
+            const std::size_t count = bus.read(samples.data(), samples.size());
+            received += count;
+            if (count == 0) {
+                std::this_thread::sleep_for(idleInterval);
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if (options.statsSeconds > 0 && now - lastStats >= statsInterval) {
+                const double seconds = std::chrono::duration<double>(now - lastStats).count();
+                std::printf("bus samples/s %.0f  lost %llu", received / seconds,
+                    static_cast<unsigned long long>(bus.lostSamples()));
+                Sample latest;
+                if (bus.latest(0, latest)) {
+                    std::printf("  ch0 %g", latest.asDouble());
+                }
+                std::printf("%s\n", bus.publisherAlive(nowNanoseconds(), quietTimeout) ? "" : "  publisher quiet");
+                std::fflush(stdout);
+                lastStats = now;
+                received = 0;
+            }
+        }
+        bus.close();
+        std::cout << "SkyLinkDaemon: stopped" << std::endl;
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    if (options.busRead) {
+        return readBus(options);
+    }
+
+    DataProvider dataProvider(1 << 16);
+
+    FlightRecorder recorder;
+    const QueuedObserver* recorderQueue = nullptr;
+    if (options.record) {
+        recorder.setEncoding(options.gorilla ? BlockEncoding::GorillaSamples : BlockEncoding::RawSamples);
+        if (!recorder.open(options.recordPath)) {
+            return 1;
+        }
+        recorderQueue = &dataProvider.attach(&recorder, BackpressurePolicy::DropNewest, 1 << 18);
+    }
+
+    TelemetryBusPublisher bus;
+    if (options.bus && bus.open(DefaultBusName, options.channels)) {
+        dataProvider.attach(&bus);
+    }
+
+    MavlinkDecoder decoder(dataProvider);
+    decoder.bindCommonTelemetry(0);
+    decoder.trackSequences(16);
+
+    // Every source posts from its own thread
+    const auto feed = [&decoder](const std::uint8_t* data, std::size_t size) {
+        decoder.feed(data, size);
+    };
+    // Held frames and link statistics go out from the receive thread too, even on a quiet link
+    const auto tick = [&decoder]() {
+        decoder.tick();
+    };
+    UdpReceiver receiver(dataProvider);
+    SerialReceiver serial;
+    LoadGenerator generator(dataProvider);
+    std::string source;
+    bool serialSource = false;
+    if (options.generateChannels > 0) {
+        ChannelLoad load;
+        load.rate = options.generateRate;
+        load.waveform = Waveform::Sine;
+        generator.addChannels(0, options.generateChannels, load);
+        generator.start();
+        source = "synthetic " + std::to_string(static_cast<long long>(generator.nominalRate())) + " samples/s";
+    }
+    else if (options.serialDevice.empty()) {
+        receiver.setPacketHandler(feed);
+        receiver.setTickHandler(tick);
+        if (!receiver.open(options.port)) {
+            return 1;
+        }
+        receiver.start();
+        source = "udp " + std::to_string(options.port);
+    }
+    else {
+        serial.setDataHandler(feed);
+        serial.setTickHandler(tick);
+        if (!serial.open(options.serialDevice, options.baudRate)) {
+            return 1;
+        }
+        serial.start();
+        serialSource = true;
+        source = options.serialDevice;
+    }
+    std::cout << "SkyLinkDaemon: listening on " << source
+        << (options.record ? ", recording to " + recorder.sessionPath() : std::string())
+        << (bus.isOpen() ? ", telemetry bus " + std::string(DefaultBusName) : std::string()) << std::endl;
+
+    // Same frame loop as the GUI, paced by a sleep instead of vsync
+    StatsPrinter stats(decoder, dataProvider, options.record ? &recorder : nullptr, recorderQueue);
+    const auto drainInterval = std::chrono::milliseconds(10);
+    const auto statsInterval = std::chrono::seconds(options.statsSeconds > 0 ? options.statsSeconds : 1);
+    auto nextStats = std::chrono::steady_clock::now() + statsInterval;
+    bool deviceLost = false;
+    while (!stopRequested) {
+        std::this_thread::sleep_for(drainInterval);
+        if (serialSource && !serial.isRunning()) {
+            // The receive thread ended on a hang-up; exit so a supervisor can restart us
+            std::cerr << "SkyLinkDaemon: lost " << options.serialDevice << ", stopping" << std::endl;
+            deviceLost = true;
+            break;
+        }
+        const auto frameStart = std::chrono::steady_clock::now();
+        dataProvider.drain();
+        stats.addFrame(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+        if (options.statsSeconds > 0 && std::chrono::steady_clock::now() >= nextStats) {
+            stats.print();
+            nextStats += statsInterval;
+        }
+    }
+
+    receiver.stop();
+    serial.stop();
+    generator.stop();
+    decoder.flush();
+    dataProvider.drain();
+    if (options.record) {
+        dataProvider.detach(&recorder); // flushes the recorder queue
+        recorder.close();
+    }
+    bus.close();
+    std::cout << "SkyLinkDaemon: stopped" << std::endl;
+    return deviceLost ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+#ifndef SKYLINE_SPSCQUEUE_H
+#define SKYLINE_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SkyLink {
+
+    // Bounded single-producer/single-consumer ring buffer.
+    // One thread calls push(), one other thread calls pop()/popBulk().
+    // When the ring is full push() drops the item and counts it.
+    template <typename T>
+    class SpscQueue {
+    public:
+        static const std::size_t CacheLineSize = 64;
+
+        explicit SpscQueue(std::size_t requestedCapacity = 4096)
+            : head(0), highWater(0), tail(0), cachedHead(0),
+            drops(0), pushes(0) {
+            std::size_t capacity = 2;
+            while (capacity < requestedCapacity) {
+                capacity <<= 1;
+            }
+            mask = capacity - 1;
+            buffer.resize(capacity);
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // Producer side
+        bool push(const T& item) {
+            if (!tryPush(item)) {
+                drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        }
+
+        // Producer side, for callers that retry instead of dropping
+        bool tryPush(const T& item) {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            if (t - cachedHead > mask) {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (t - cachedHead > mask) {
+                    return false;
+                }
+            }
+            buffer[t & mask] = item;
+            tail.store(t + 1, std::memory_order_release);
+
+            pushes.store(pushes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Consumer side
+        bool pop(T& item) {
+            return popBulk(&item, 1) == 1;
+        }
+
+        // Consumer side, moves up to maxCount items into out in one pass
+        std::size_t popBulk(T* out, std::size_t maxCount) {
+            const std::size_t h = head.load(std::memory_order_relaxed);
+            const std::size_t available = tail.load(std::memory_order_acquire) - h;
+            if (available > highWater.load(std::memory_order_relaxed)) {
+                highWater.store(available, std::memory_order_relaxed);
+            }
+            const std::size_t count = available < maxCount ? available : maxCount;
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = buffer[(h + i) & mask];
+            }
+            if (count > 0) {
+                head.store(h + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        std::size_t size() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+        std::size_t capacity() const { return mask + 1; }
+        std::size_t highWaterMark() const { return highWater.load(std::memory_order_relaxed); }
+        std::uint64_t dropCount() const { return drops.load(std::memory_order_relaxed); }
+        std::uint64_t pushCount() const { return pushes.load(std::memory_order_relaxed); }
+
+    private:
+        // Consumer-owned line; the high-water mark is the deepest backlog seen by a drain
+        alignas(CacheLineSize) std::atomic<std::size_t> head;
+        std::atomic<std::size_t> highWater;
+
+        // Producer-owned line
+        alignas(CacheLineSize) std::atomic<std::size_t> tail;
+        std::size_t cachedHead;
+        std::atomic<std::uint64_t> drops;
+        std::atomic<std::uint64_t> pushes;
+
+        // Shared, read-only after construction
+        alignas(CacheLineSize) std::size_t mask;
+        std::vector<T> buffer;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_SPSCQUEUE_H
@@ -0,0 +1,169 @@
+// Rolling statistics over a long run against a brute-force window: mean and
+// standard deviation from Welford add/remove (with the exact recompute once
+// per ring lap and after spikes or level steps leave the window) must stay
+// within rounding of a two-pass sum over the same samples, and min/max from
+// the monotonic deques must match exactly. The window is bounded by both
+// count and duration, timestamps have gaps that empty it, and the inputs
+// include a large offset with small noise, steps, long ramps and NaNs,
+// which are skipped.
+#include "Bench.h"
+#include "RollingStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::size_t ChannelCount = 3;
+        const std::size_t WindowSamples = 1000;
+        const std::int64_t WindowDuration = 800ll * 1000 * 1000; // 0.8 s, shorter than 1000 samples at 1 kHz
+        const std::size_t Steps = 400000;
+        const std::size_t CheckEvery = 97;
+
+        struct Exact {
+            std::uint64_t count = 0;
+            double mean = 0.0;
+            double stddev = 0.0;
+            double min = 0.0;
+            double max = 0.0;
+        };
+
+        // The same eviction rules, kept as a plain list of (timestamp, value)
+        class BruteWindow {
+        public:
+            void add(std::int64_t timestamp, double value) {
+                if (std::isnan(value)) {
+                    return;
+                }
+                if (samples.size() == WindowSamples) {
+                    samples.pop_front();
+                }
+                while (!samples.empty() && samples.front().first <= timestamp - WindowDuration) {
+                    samples.pop_front();
+                }
+                samples.emplace_back(timestamp, value);
+            }
+
+            Exact stats() const {
+                Exact exact;
+                exact.count = samples.size();
+                long double sum = 0.0L;
+                for (const auto& sample : samples) {
+                    sum += sample.second;
+                }
+                const long double mean = sum / static_cast<long double>(samples.size());
+                long double squares = 0.0L;
+                exact.min = std::numeric_limits<double>::infinity();
+                exact.max = -std::numeric_limits<double>::infinity();
+                for (const auto& sample : samples) {
+                    const long double d = sample.second - mean;
+                    squares += d * d;
+                    exact.min = std::min(exact.min, sample.second);
+                    exact.max = std::max(exact.max, sample.second);
+                }
+                exact.mean = static_cast<double>(mean);
+                exact.stddev = samples.size() > 1 ?
+                    static_cast<double>(std::sqrt(squares / static_cast<long double>(samples.size() - 1))) : 0.0;
+                return exact;
+            }
+
+        private:
+            std::deque<std::pair<std::int64_t, double>> samples;
+        };
+
+        // 0: 1e6 offset, noise of a few units, occasional steps of 1e3
+        // 1: random walk with rare spikes either way
+        // 2: long ramps up and down, the worst case for the deques; every 1000th sample NaN
+        double valueFor(std::size_t channel, std::size_t step, std::mt19937_64& random, double& walk) {
+            const double noise = static_cast<double>(static_cast<std::int64_t>(random() % 2001) - 1000) / 256.0;
+            switch (channel) {
+            case 0:
+                return 1e6 + 1e3 * static_cast<double>((step / 30011) % 3) + noise;
+            case 1:
+                walk += noise;
+                return random() % 5000 == 0 ? walk + (random() % 2 ? 1e9 : -1e9) : walk;
+            default:
+                if (step % 1000 == 999) {
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+                return static_cast<double>((step / 5000) % 2 ? 5000 - step % 5000 : step % 5000) * 0.125;
+            }
+        }
+
+    } // namespace
+
+    bool benchRollingStats() {
+        RollingStats stats(ChannelCount, WindowSamples, WindowDuration);
+        BruteWindow brute[ChannelCount];
+        std::mt19937_64 random(2026);
+        double walk[ChannelCount] = {};
+
+        double meanError = 0.0;   // relative to the spread of the window
+        double stddevError = 0.0; // relative to the standard deviation
+        std::size_t checks = 0;
+        std::size_t extremeMismatches = 0;
+        std::size_t countMismatches = 0;
+        std::int64_t timestamp = 0;
+        std::vector<Sample> batch(ChannelCount);
+        for (std::size_t step = 0; step < Steps; ++step) {
+            // 1 kHz with a gap long enough to empty the window now and then
+            timestamp += step % 50000 == 49999 ? 900ll * 1000 * 1000 : 1000ll * 1000;
+            for (std::size_t channel = 0; channel < ChannelCount; ++channel) {
+                const double value = valueFor(channel, step, random, walk[channel]);
+                batch[channel] = Sample::fromDouble(static_cast<ChannelId>(channel), timestamp, value);
+                brute[channel].add(timestamp, value);
+            }
+            stats.process(batch.data(), batch.size());
+
+            if (step % CheckEvery != 0) {
+                continue;
+            }
+            for (std::size_t channel = 0; channel < ChannelCount; ++channel) {
+                RollingStats::Snapshot snapshot;
+                if (!stats.snapshot(static_cast<ChannelId>(channel), snapshot)) {
+                    ++countMismatches;
+                    continue;
+                }
+                const Exact exact = brute[channel].stats();
+                ++checks;
+                if (snapshot.count != exact.count) {
+                    ++countMismatches;
+                    continue;
+                }
+                if (snapshot.min != exact.min || snapshot.max != exact.max) {
+                    ++extremeMismatches;
+                }
+                const double spread = std::max(exact.max - exact.min, 1.0);
+                meanError = std::max(meanError, std::fabs(snapshot.mean - exact.mean) / spread);
+                stddevError = std::max(stddevError, std::fabs(snapshot.stddev - exact.stddev) / std::max(exact.stddev, 1.0));
+            }
+        }
+
+        // Throughput of add() alone on the same kind of stream
+        RollingStats timed(ChannelCount, WindowSamples, WindowDuration);
+        const auto start = std::chrono::steady_clock::now();
+        timestamp = 0;
+        for (std::size_t step = 0; step < Steps; ++step) {
+            timestamp += 1000ll * 1000;
+            for (std::size_t channel = 0; channel < ChannelCount; ++channel) {
+                batch[channel] = Sample::fromDouble(static_cast<ChannelId>(channel), timestamp,
+                    valueFor(channel, step, random, walk[channel]));
+            }
+            timed.process(batch.data(), batch.size());
+        }
+        const double seconds = secondsSince(start);
+
+        std::printf("%zu checks over %zu samples: worst mean error %.2e of the range, worst stddev error %.2e, "
+            "min/max mismatches %zu, count mismatches %zu; %.1f ns/sample\n", checks, Steps * ChannelCount,
+            meanError, stddevError, extremeMismatches, countMismatches, seconds / (Steps * ChannelCount) * 1e9);
+        return checks > 0 && countMismatches == 0 && extremeMismatches == 0 && meanError < 1e-8 && stddevError < 1e-8;
+    }
+
+} // namespace SkyLine
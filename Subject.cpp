@@ -6,15 +6,83 @@ namespace SkyLink {
         observers.push_back(observer);
     }
 
+    void Subject::attach(Observer* observer, ChannelId channel) {
+        if (channel >= channelObservers.size()) {
+            channelObservers.resize(static_cast<std::size_t>(channel) + 1);
+        }
+        channelObservers[channel].push_back(observer);
+    }
+
+    QueuedObserver& Subject::attach(Observer* observer, BackpressurePolicy policy, std::size_t capacity) {
+        queues.emplace_back(new QueuedObserver(*observer, policy, capacity));
+        QueuedObserver& queue = *queues.back();
+        queue.start();
+        observers.push_back(&queue);
+        return queue;
+    }
+
+    const QueuedObserver* Subject::queueOf(const Observer* observer) const {
+        for (const auto& queue : queues) {
+            if (&queue->target() == observer) {
+                return queue.get();
+            }
+        }
+        return nullptr;
+    }
+
     void Subject::detach(Observer* observer) {
+        // A queued subscriber goes away with its queue; stop() hands it what is still pending
+        for (auto it = queues.begin(); it != queues.end();) {
+            if (&(*it)->target() == observer) {
+                QueuedObserver* queue = it->get();
+                observers.erase(std::remove(observers.begin(), observers.end(), queue), observers.end());
+                queue->stop();
+                it = queues.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
         observers.erase(
             std::remove(observers.begin(), observers.end(), observer),
             observers.end());
+        for (auto& list : channelObservers) {
+            list.erase(std::remove(list.begin(), list.end(), observer), list.end());
+        }
+    }
+
+    void Subject::detach(Observer* observer, ChannelId channel) {
+        if (channel >= channelObservers.size()) {
+            return;
+        }
+        auto& list = channelObservers[channel];
+        list.erase(std::remove(list.begin(), list.end(), observer), list.end());
     }
 
-    void Subject::notify(int newData) {
+    void Subject::notifyBatch(SampleSpan samples) {
+        if (samples.empty()) {
+            return;
+        }
         for (auto observer : observers) {
-            observer->onDataUpdated(newData);
+            observer->onSamples(samples);
+        }
+
+        // Channel subscribers only see runs of their own channel
+        const std::size_t channelCount = channelObservers.size();
+        std::size_t runStart = 0;
+        while (runStart < samples.size()) {
+            const ChannelId channel = samples[runStart].channel;
+            std::size_t runEnd = runStart + 1;
+            while (runEnd < samples.size() && samples[runEnd].channel == channel) {
+                ++runEnd;
+            }
+            if (channel < channelCount) {
+                SampleSpan run(samples.data() + runStart, runEnd - runStart);
+                for (auto observer : channelObservers[channel]) {
+                    observer->onSamples(run);
+                }
+            }
+            runStart = runEnd;
         }
     }
 
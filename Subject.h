@@ -3,17 +3,32 @@
 
 #include <vector>
 #include <algorithm>
+#include <memory>
 #include "Observer.h"
+#include "QueuedObserver.h"
 
 namespace SkyLink {
 
     class Subject {
     private:
-        std::vector<Observer*> observers;
+        std::vector<Observer*> observers;                     // receive every sample
+        std::vector<std::vector<Observer*>> channelObservers; // indexed by dense channel id
+        std::vector<std::unique_ptr<QueuedObserver>> queues;  // slow subscribers, each on its own thread
     public:
         void attach(Observer* observer);
+        void attach(Observer* observer, ChannelId channel);
+        // Receive every sample through a bounded queue drained by a dedicated thread;
+        // for LatestOnly, capacity is the channel count
+        QueuedObserver& attach(Observer* observer, BackpressurePolicy policy,
+            std::size_t capacity = QueuedObserver::DefaultCapacity);
         void detach(Observer* observer);
-        void notify(int newData);
+        void detach(Observer* observer, ChannelId channel);
+        void notifyBatch(SampleSpan samples);
+
+        // Queue of a subscriber attached with a policy, nullptr otherwise (drop counters for the UI)
+        const QueuedObserver* queueOf(const Observer* observer) const;
+        std::size_t queueCount() const { return queues.size(); }
+        const QueuedObserver& queue(std::size_t index) const { return *queues[index]; }
     };
 
 } // namespace SkyLine
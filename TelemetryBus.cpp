@@ -0,0 +1,285 @@
+#include "TelemetryBus.h"
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace SkyLink {
+
+    namespace {
+        const std::size_t Alignment = 64;
+
+        std::uint64_t alignUp(std::uint64_t value) {
+            return (value + Alignment - 1) & ~static_cast<std::uint64_t>(Alignment - 1);
+        }
+
+        std::uint32_t currentProcess() {
+#ifdef _WIN32
+            return static_cast<std::uint32_t>(GetCurrentProcessId());
+#else
+            return static_cast<std::uint32_t>(::getpid());
+#endif
+        }
+
+        bool processAlive(std::uint32_t process) {
+#ifdef _WIN32
+            HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(process));
+            if (!handle) {
+                return GetLastError() == ERROR_ACCESS_DENIED;
+            }
+            const bool running = WaitForSingleObject(handle, 0) == WAIT_TIMEOUT;
+            CloseHandle(handle);
+            return running;
+#else
+            return ::kill(static_cast<pid_t>(process), 0) == 0 || errno == EPERM;
+#endif
+        }
+
+        // Whether the segment under name may be replaced: a bus whose publisher closed it or
+        // died. One still starting up, or something that is not a bus at all, is left alone.
+        bool isStaleBus(const std::string& name) {
+            SharedMemory existing;
+            if (!existing.openReadOnly(name)) {
+                return false;
+            }
+            const BusHeader* header = reinterpret_cast<const BusHeader*>(existing.data());
+            if (existing.size() < sizeof(BusHeader) || std::memcmp(header->magic, BusMagic, sizeof(BusMagic)) != 0) {
+                return false;
+            }
+            const std::uint32_t state = header->state.load(std::memory_order_acquire);
+            if (state == static_cast<std::uint32_t>(BusState::Closed)) {
+                return true;
+            }
+            return header->publisherProcess != 0 && !processAlive(header->publisherProcess);
+        }
+    }
+
+    TelemetryBusPublisher::TelemetryBusPublisher()
+        : header(nullptr), table(nullptr), ring(nullptr), mask(0) {}
+
+    TelemetryBusPublisher::~TelemetryBusPublisher() {
+        close();
+    }
+
+    bool TelemetryBusPublisher::open(const std::string& name, ChannelId channelCount, std::size_t ringSamples) {
+        close();
+        std::uint64_t capacity = 2;
+        while (capacity < ringSamples) {
+            capacity <<= 1;
+        }
+        const std::uint64_t tableOffset = alignUp(sizeof(BusHeader));
+        const std::uint64_t ringOffset = alignUp(tableOffset + static_cast<std::uint64_t>(channelCount) * sizeof(Seqlock<Sample>));
+        const std::uint64_t totalSize = ringOffset + capacity * sizeof(Sample);
+        if (!memory.create(name, static_cast<std::size_t>(totalSize))) {
+            // Never take the name from a live publisher: the first one to close would unlink the other's bus
+            if (!isStaleBus(name)) {
+                std::cerr << "ERROR::TELEMETRYBUS::" << name << " has a live publisher or is not a telemetry bus" << std::endl;
+                return false;
+            }
+            if (!SharedMemory::remove(name) || !memory.create(name, static_cast<std::size_t>(totalSize))) {
+                std::cerr << "ERROR::TELEMETRYBUS::Could not replace the stale bus " << name << std::endl;
+                return false;
+            }
+        }
+
+        std::uint8_t* base = memory.data();
+        BusHeader* created = new (base) BusHeader();
+        created->state.store(static_cast<std::uint32_t>(BusState::Starting), std::memory_order_relaxed);
+        std::memcpy(created->magic, BusMagic, sizeof(BusMagic));
+        created->version = BusVersion;
+        created->headerSize = sizeof(BusHeader);
+        created->channelCount = channelCount;
+        created->publisherProcess = currentProcess();
+        created->ringCapacity = capacity;
+        created->tableOffset = tableOffset;
+        created->ringOffset = ringOffset;
+        created->totalSize = totalSize;
+        created->padding = 0;
+        created->claim.store(0, std::memory_order_relaxed);
+        created->cursor.store(0, std::memory_order_relaxed);
+        created->heartbeat.store(nowNanoseconds(), std::memory_order_relaxed);
+
+        table = reinterpret_cast<Seqlock<Sample>*>(base + tableOffset);
+        for (ChannelId channel = 0; channel < channelCount; ++channel) {
+            new (table + channel) Seqlock<Sample>();
+        }
+        ring = reinterpret_cast<Sample*>(base + ringOffset);
+        mask = capacity - 1;
+
+        // Readers look at nothing else until they see Live
+        created->state.store(static_cast<std::uint32_t>(BusState::Live), std::memory_order_release);
+        header = created;
+        return true;
+    }
+
+    void TelemetryBusPublisher::close() {
+        if (header) {
+            header->state.store(static_cast<std::uint32_t>(BusState::Closed), std::memory_order_release);
+            header = nullptr;
+            table = nullptr;
+            ring = nullptr;
+        }
+        memory.close();
+    }
+
+    void TelemetryBusPublisher::onSamples(SampleSpan samples) {
+        if (!header || samples.empty()) {
+            return;
+        }
+        const ChannelId channelCount = header->channelCount;
+        for (const Sample& sample : samples) {
+            if (sample.channel < channelCount) {
+                table[sample.channel].store(sample);
+            }
+        }
+
+        // A batch longer than the ring only leaves its tail behind
+        const std::uint64_t start = header->cursor.load(std::memory_order_relaxed);
+        const std::uint64_t end = start + samples.size();
+        const std::uint64_t capacity = mask + 1;
+        const std::size_t skip = samples.size() > capacity ? static_cast<std::size_t>(samples.size() - capacity) : 0;
+
+        // Claim first so readers can tell which of their samples may be overwritten below
+        header->claim.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::uint64_t position = start + skip;
+        const Sample* source = samples.data() + skip;
+        std::size_t remaining = samples.size() - skip;
+        while (remaining > 0) {
+            const std::size_t slot = static_cast<std::size_t>(position & mask);
+            std::size_t run = static_cast<std::size_t>(capacity) - slot;
+            run = run < remaining ? run : remaining;
+            std::memcpy(ring + slot, source, run * sizeof(Sample));
+            source += run;
+            position += run;
+            remaining -= run;
+        }
+        header->cursor.store(end, std::memory_order_release);
+        header->heartbeat.store(nowNanoseconds(), std::memory_order_relaxed);
+    }
+
+    TelemetryBusReader::TelemetryBusReader()
+        : header(nullptr), table(nullptr), ring(nullptr), mask(0), position(0), lost(0) {}
+
+    bool TelemetryBusReader::open(const std::string& name) {
+        close();
+        if (!memory.openReadOnly(name)) {
+            return false;
+        }
+        const std::uint8_t* base = memory.data();
+        const BusHeader* mapped = reinterpret_cast<const BusHeader*>(base);
+        if (memory.size() < sizeof(BusHeader) ||
+            mapped->state.load(std::memory_order_acquire) != static_cast<std::uint32_t>(BusState::Live) ||
+            std::memcmp(mapped->magic, BusMagic, sizeof(BusMagic)) != 0 ||
+            mapped->version != BusVersion || mapped->headerSize != sizeof(BusHeader) ||
+            mapped->totalSize > memory.size()) {
+            std::cerr << "ERROR::TELEMETRYBUS::" << name << " is not a live telemetry bus" << std::endl;
+            memory.close();
+            return false;
+        }
+        header = mapped;
+        table = reinterpret_cast<const Seqlock<Sample>*>(base + mapped->tableOffset);
+        ring = reinterpret_cast<const Sample*>(base + mapped->ringOffset);
+        mask = mapped->ringCapacity - 1;
+        position = mapped->cursor.load(std::memory_order_acquire);
+        lost = 0;
+        return true;
+    }
+
+    void TelemetryBusReader::close() {
+        header = nullptr;
+        table = nullptr;
+        ring = nullptr;
+        memory.close();
+    }
+
+    bool TelemetryBusReader::publisherAlive(std::int64_t now, std::int64_t timeout) const {
+        return header && header->state.load(std::memory_order_acquire) == static_cast<std::uint32_t>(BusState::Live) &&
+            now - header->heartbeat.load(std::memory_order_relaxed) <= timeout;
+    }
+
+    bool TelemetryBusReader::latest(ChannelId channel, Sample& out) const {
+        if (!header || channel >= header->channelCount || table[channel].version() == 0) {
+            return false;
+        }
+        out = table[channel].load();
+        return true;
+    }
+
+    bool TelemetryBusReader::catchUp(std::uint64_t end) {
+        const std::uint64_t capacity = mask + 1;
+        if (end - position <= capacity) {
+            return false;
+        }
+        lost += end - capacity - position;
+        position = end - capacity;
+        return true;
+    }
+
+    std::size_t TelemetryBusReader::read(Sample* out, std::size_t maxCount) {
+        if (!header) {
+            return 0;
+        }
+        const std::uint64_t capacity = mask + 1;
+        for (;;) {
+            const std::uint64_t end = header->cursor.load(std::memory_order_acquire);
+            catchUp(end);
+            std::uint64_t available = end - position;
+            const std::size_t count = static_cast<std::size_t>(available < maxCount ? available : maxCount);
+
+            std::size_t copied = 0;
+            while (copied < count) {
+                const std::size_t slot = static_cast<std::size_t>((position + copied) & mask);
+                std::size_t run = static_cast<std::size_t>(capacity) - slot;
+                run = run < count - copied ? run : count - copied;
+                std::memcpy(out + copied, ring + slot, run * sizeof(Sample));
+                copied += run;
+            }
+
+            // Anything the writer claimed meanwhile may have replaced what was just copied
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!catchUp(header->claim.load(std::memory_order_relaxed))) {
+                position += count;
+                return count;
+            }
+        }
+    }
+
+    SampleSpan TelemetryBusReader::peek(std::size_t maxCount) {
+        if (!header) {
+            return SampleSpan();
+        }
+        const std::uint64_t end = header->cursor.load(std::memory_order_acquire);
+        catchUp(end);
+        const std::size_t slot = static_cast<std::size_t>(position & mask);
+        std::uint64_t count = end - position;
+        const std::uint64_t untilWrap = mask + 1 - slot;
+        count = count < untilWrap ? count : untilWrap;
+        count = count < maxCount ? count : maxCount;
+        return SampleSpan(ring + slot, static_cast<std::size_t>(count));
+    }
+
+    bool TelemetryBusReader::release(std::size_t count) {
+        if (!header) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (catchUp(header->claim.load(std::memory_order_relaxed))) {
+            return false;
+        }
+        position += count;
+        return true;
+    }
+
+} // namespace SkyLine
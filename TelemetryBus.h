@@ -0,0 +1,129 @@
+#ifndef SKYLINE_TELEMETRYBUS_H
+#define SKYLINE_TELEMETRYBUS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Observer.h"
+#include "Seqlock.h"
+#include "SharedMemory.h"
+
+namespace SkyLink {
+
+    // Shared-memory telemetry bus for local tools (flight dynamics, loggers,
+    // extra displays). One publisher process maps a named segment holding:
+    //   BusHeader | Seqlock<Sample> latest value per channel | Sample ring
+    // Readers map it read-only, so any number can attach without affecting
+    // the publisher. The ring is a broadcast ring: the writer never waits,
+    // each reader keeps its own position and finds out from the claim counter
+    // when it has been lapped.
+    //
+    //   TelemetryBusReader bus;
+    //   if (bus.open(DefaultBusName)) {
+    //       for (;;) {
+    //           SampleSpan run = bus.peek();
+    //           for (const Sample& sample : run) { ... }
+    //           if (!bus.release(run.size())) { ... part of run was overwritten meanwhile }
+    //       }
+    //   }
+
+    const char BusMagic[8] = { 'S', 'K', 'Y', 'L', 'B', 'U', 'S', '1' };
+    const std::uint32_t BusVersion = 1;
+    const char* const DefaultBusName = "/skylink-telemetry"; // POSIX shm name; Local\skylink-telemetry on Windows
+
+    enum class BusState : std::uint32_t {
+        Starting = 0,
+        Live = 1,
+        Closed = 2
+    };
+
+    struct BusHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint32_t channelCount;
+        std::uint32_t publisherProcess; // process id, so a second publisher can tell a live bus from a stale one
+        std::uint64_t ringCapacity; // samples, power of two
+        std::uint64_t tableOffset;
+        std::uint64_t ringOffset;
+        std::uint64_t totalSize;
+        std::uint64_t padding;
+
+        // Writer-owned line, read by everyone
+        alignas(64) std::atomic<std::uint64_t> claim;  // ring positions being written, ahead of cursor
+        std::atomic<std::uint64_t> cursor;             // ring positions fully written
+        std::atomic<std::int64_t> heartbeat;           // last publish, nanoseconds
+        std::atomic<std::uint32_t> state;              // BusState
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the bus needs address-free 64-bit atomics");
+    static_assert(sizeof(BusHeader) == 128, "BusHeader layout is shared between processes");
+
+    class TelemetryBusPublisher : public Observer {
+    public:
+        static const std::size_t DefaultRingSamples = 1 << 16;
+
+        TelemetryBusPublisher();
+        ~TelemetryBusPublisher();
+
+        // Channels at or above channelCount go into the ring but not the latest-value table.
+        // Fails while another publisher holds the name; a bus left behind by a
+        // closed or dead publisher is replaced.
+        bool open(const std::string& name, ChannelId channelCount, std::size_t ringSamples = DefaultRingSamples);
+        void close();
+
+        void onSamples(SampleSpan samples) override;
+
+        bool isOpen() const { return header != nullptr; }
+        std::uint64_t published() const { return header ? header->cursor.load(std::memory_order_relaxed) : 0; }
+
+    private:
+        SharedMemory memory;
+        BusHeader* header;
+        Seqlock<Sample>* table;
+        Sample* ring;
+        std::uint64_t mask;
+    };
+
+    class TelemetryBusReader {
+    public:
+        TelemetryBusReader();
+
+        // Attaches to a live bus; reading starts with the next published sample
+        bool open(const std::string& name);
+        void close();
+        bool isOpen() const { return header != nullptr; }
+
+        ChannelId channelCount() const { return header ? header->channelCount : 0; }
+        bool publisherAlive(std::int64_t now, std::int64_t timeout) const;
+
+        // Latest value of one channel; false if never published or the channel is out of range
+        bool latest(ChannelId channel, Sample& out) const;
+
+        // Copies up to maxCount unread samples, skipping (and counting) whatever was overwritten
+        std::size_t read(Sample* out, std::size_t maxCount);
+
+        // Zero-copy view of the next unread run inside the segment (stops at the ring's end).
+        // Call release() once done with it: false means the writer lapped part of the run
+        // while it was being used, so what was read from it cannot be trusted.
+        SampleSpan peek(std::size_t maxCount = static_cast<std::size_t>(-1));
+        bool release(std::size_t count);
+
+        std::uint64_t lostSamples() const { return lost; }
+
+    private:
+        bool catchUp(std::uint64_t end); // moves position up to the oldest sample still in the ring
+
+        SharedMemory memory;
+        const BusHeader* header;
+        const Seqlock<Sample>* table;
+        const Sample* ring;
+        std::uint64_t mask;
+        std::uint64_t position;
+        std::uint64_t lost;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_TELEMETRYBUS_H
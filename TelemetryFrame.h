@@ -0,0 +1,66 @@
+#ifndef SKYLINE_TELEMETRYFRAME_H
+#define SKYLINE_TELEMETRYFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    // Latest sample per channel for one tick (indexed by channel id). Integer
+    // fields are kept as int64 so 64-bit counters survive unchanged. Decoders
+    // write into it; DataProvider::postFrame publishes the channels touched
+    // since the last clearUpdated().
+    class TelemetryFrame {
+    public:
+        explicit TelemetryFrame(std::size_t channelCount = 0) { resize(channelCount); }
+
+        void resize(std::size_t channelCount) {
+            const std::size_t first = samples.size();
+            samples.resize(channelCount);
+            for (std::size_t channel = first; channel < channelCount; ++channel) {
+                samples[channel] = Sample::fromDouble(static_cast<ChannelId>(channel), 0, 0.0);
+            }
+            updatedFlags.resize(channelCount, 0);
+        }
+
+        std::size_t channelCount() const { return samples.size(); }
+
+        void set(ChannelId channel, std::int64_t timestamp, double value) {
+            markUpdated(channel);
+            samples[channel] = Sample::fromDouble(channel, timestamp, value);
+        }
+
+        void setInt(ChannelId channel, std::int64_t timestamp, std::int64_t value) {
+            markUpdated(channel);
+            samples[channel] = Sample::fromInt(channel, timestamp, value);
+        }
+
+        const Sample& sample(ChannelId channel) const { return samples[channel]; }
+
+        const std::vector<ChannelId>& updatedChannels() const { return updated; }
+
+        void clearUpdated() {
+            for (ChannelId channel : updated) {
+                updatedFlags[channel] = 0;
+            }
+            updated.clear();
+        }
+
+    private:
+        void markUpdated(ChannelId channel) {
+            if (!updatedFlags[channel]) {
+                updatedFlags[channel] = 1;
+                updated.push_back(channel);
+            }
+        }
+
+        std::vector<Sample> samples;
+        std::vector<std::uint8_t> updatedFlags;
+        std::vector<ChannelId> updated;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_TELEMETRYFRAME_H
@@ -0,0 +1,19 @@
+#ifndef SKYLINE_TELEMETRYSTAGE_H
+#define SKYLINE_TELEMETRYSTAGE_H
+
+#include <cstddef>
+#include "Sample.h"
+
+namespace SkyLink {
+
+    // Processing step run by DataProvider::drain() on each drained batch,
+    // in place and before observers are notified.
+    class TelemetryStage {
+    public:
+        virtual void process(Sample* samples, std::size_t count) = 0;
+        virtual ~TelemetryStage() = default;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_TELEMETRYSTAGE_H
@@ -0,0 +1,96 @@
+#include "ThreadPool.h"
+
+namespace SkyLink {
+
+    ThreadPool::ThreadPool(unsigned threadCount)
+        : job(nullptr), jobCount(0), next(0), active(0), generation(0), stopping(false) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+        }
+        for (unsigned slot = 1; slot < threadCount; ++slot) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, slot);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, unsigned)>& task) {
+        if (count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> callLock(callMutex);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            jobCount = count;
+            next.store(0, std::memory_order_relaxed);
+            active = static_cast<unsigned>(workers.size());
+            ++generation;
+        }
+        wake.notify_all();
+
+        runTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return active == 0; });
+        job = nullptr;
+        if (failure) {
+            // Only now, with no worker still calling task
+            std::exception_ptr error = failure;
+            failure = nullptr;
+            lock.unlock();
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::runTasks(unsigned slot) {
+        for (;;) {
+            const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= jobCount) {
+                return;
+            }
+            try {
+                (*job)(index, slot);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next.store(jobCount, std::memory_order_relaxed); // hand out no more indices
+                return;
+            }
+        }
+    }
+
+    void ThreadPool::workerLoop(unsigned slot) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+
+            runTasks(slot);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,57 @@
+#ifndef SKYLINE_THREADPOOL_H
+#define SKYLINE_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    // Fixed set of worker threads for data-parallel jobs. parallelFor() hands
+    // out indices one at a time from an atomic counter, so uneven tasks balance
+    // themselves; the calling thread works too and returns when all are done.
+    // A task that throws stops the job handing out indices; parallelFor()
+    // still waits for the tasks already running, then rethrows the first
+    // exception on the calling thread.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned threadCount = 0); // 0: one per hardware thread
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Threads taking part in a job, including the caller
+        unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+        // task(index, slot): slot is in [0, size()) and unique among concurrently running calls
+        void parallelFor(std::size_t count, const std::function<void(std::size_t, unsigned)>& task);
+
+    private:
+        void workerLoop(unsigned slot);
+        void runTasks(unsigned slot);
+
+        std::vector<std::thread> workers;
+        std::mutex callMutex; // one job at a time
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+
+        const std::function<void(std::size_t, unsigned)>* job;
+        std::size_t jobCount;
+        std::atomic<std::size_t> next;
+        unsigned active;
+        std::uint64_t generation;
+        bool stopping;
+        std::exception_ptr failure; // first exception of the current job
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_THREADPOOL_H
@@ -0,0 +1,141 @@
+#include "TimestampMerger.h"
+#include <algorithm>
+#include <limits>
+
+namespace SkyLink {
+
+    namespace {
+
+        struct LaterSample {
+            bool operator()(const Sample& a, const Sample& b) const { return a.timestamp > b.timestamp; }
+        };
+
+        template <typename Head>
+        struct LaterHead {
+            bool operator()(const Head& a, const Head& b) const { return a.timestamp > b.timestamp; }
+        };
+
+    } // namespace
+
+    TimestampMerger::TimestampMerger(std::int64_t idleTimeout)
+        : idleTimeout(idleTimeout), released(std::numeric_limits<std::int64_t>::min()) {}
+
+    std::size_t TimestampMerger::addSource(DataProvider& provider, std::int64_t lateness, std::size_t window) {
+        Source source;
+        source.queue = &provider.ingestQueue();
+        source.lateness = lateness;
+        source.maxSeen = std::numeric_limits<std::int64_t>::min();
+        source.lastArrival = std::numeric_limits<std::int64_t>::min();
+        source.capacity = window < 1 ? 1 : window;
+        source.window.reserve(source.capacity);
+        source.stats = SourceStats{ 0, 0, 0 };
+        sources.push_back(std::move(source));
+        heads.reserve(sources.size());
+        return sources.size() - 1;
+    }
+
+    std::size_t TimestampMerger::buffered() const {
+        std::size_t count = 0;
+        for (const Source& source : sources) {
+            count += source.window.size();
+        }
+        return count;
+    }
+
+    bool TimestampMerger::fill(Source& source, std::int64_t now) {
+        bool received = false;
+        Sample sample;
+        while (source.window.size() < source.capacity && source.queue->pop(sample)) {
+            received = true;
+            ++source.stats.received;
+            if (sample.timestamp < released) {
+                ++source.stats.late;
+                continue;
+            }
+            source.maxSeen = std::max(source.maxSeen, sample.timestamp);
+            source.window.push_back(sample); // within reserved capacity, no allocation
+            std::push_heap(source.window.begin(), source.window.end(), LaterSample());
+        }
+        if (received) {
+            source.lastArrival = now;
+        }
+        return received;
+    }
+
+    std::int64_t TimestampMerger::watermark(std::int64_t now) const {
+        // Oldest timestamp any live source may still deliver; quiet sources do not hold it back
+        std::int64_t mark = std::numeric_limits<std::int64_t>::max();
+        for (const Source& source : sources) {
+            const bool idle = source.lastArrival == std::numeric_limits<std::int64_t>::min() ||
+                now - source.lastArrival > idleTimeout;
+            if (idle && source.queue->empty()) {
+                continue;
+            }
+            if (source.maxSeen == std::numeric_limits<std::int64_t>::min()) {
+                return std::numeric_limits<std::int64_t>::min();
+            }
+            mark = std::min(mark, source.maxSeen - source.lateness);
+        }
+        return mark;
+    }
+
+    std::size_t TimestampMerger::pump(DataProvider& output, std::int64_t now) {
+        std::size_t count = 0;
+        for (;;) {
+            bool progress = false;
+            for (Source& source : sources) {
+                progress |= fill(source, now);
+            }
+
+            heads.clear();
+            bool anyFull = false;
+            for (std::uint32_t i = 0; i < sources.size(); ++i) {
+                if (!sources[i].window.empty()) {
+                    heads.push_back(Head{ sources[i].window.front().timestamp, i });
+                }
+                anyFull |= sources[i].window.size() >= sources[i].capacity;
+            }
+            std::make_heap(heads.begin(), heads.end(), LaterHead<Head>());
+
+            const std::int64_t mark = watermark(now);
+            while (!heads.empty()) {
+                std::pop_heap(heads.begin(), heads.end(), LaterHead<Head>());
+                Head head = heads.back();
+                heads.pop_back();
+                Source& source = sources[head.source];
+
+                // Release when no live source can still send anything older, or
+                // when any window is full: a full source stops taking from its
+                // queue, so the oldest sample overall goes to make progress
+                const bool forced = head.timestamp > mark;
+                if (forced && !anyFull) {
+                    break;
+                }
+                if (forced) {
+                    ++source.stats.forced;
+                }
+                const bool full = source.window.size() >= source.capacity;
+
+                std::pop_heap(source.window.begin(), source.window.end(), LaterSample());
+                output.post(source.window.back());
+                released = source.window.back().timestamp;
+                source.window.pop_back();
+                ++count;
+                progress = true;
+
+                if (!source.window.empty()) {
+                    heads.push_back(Head{ source.window.front().timestamp, head.source });
+                    std::push_heap(heads.begin(), heads.end(), LaterHead<Head>());
+                }
+                if (full || forced) {
+                    break; // refill from the queues and check again before going on
+                }
+            }
+
+            if (!progress) {
+                return count;
+            }
+        }
+    }
+
+} // namespace SkyLine
@@ -0,0 +1,69 @@
+#ifndef SKYLINE_TIMESTAMPMERGER_H
+#define SKYLINE_TIMESTAMPMERGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DataProvider.h"
+
+namespace SkyLink {
+
+    // Merges several telemetry sources into one time-ordered stream. Each
+    // source is a DataProvider its receiver posts to as usual; pump() pulls
+    // their queues into per-source reorder windows (fixed-capacity heaps) and
+    // releases samples through a min-heap of source heads once no live source
+    // can still deliver anything older. A sample older than what was already
+    // released is dropped and counted, so the output never goes back in time.
+    class TimestampMerger {
+    public:
+        struct SourceStats {
+            std::uint64_t received;
+            std::uint64_t late;    // dropped, older than the merged stream
+            std::uint64_t forced;  // released early because a source's window was full
+        };
+
+        static const std::size_t DefaultWindow = 4096;
+        static const std::int64_t DefaultIdleTimeout = 500ll * 1000 * 1000; // 0.5 s
+
+        explicit TimestampMerger(std::int64_t idleTimeout = DefaultIdleTimeout);
+
+        // lateness: how far (ns) this source may deliver out of order.
+        // Returns the source index. Add every source before the first pump().
+        std::size_t addSource(DataProvider& source, std::int64_t lateness, std::size_t window = DefaultWindow);
+
+        // Moves every releasable sample into output in timestamp order; returns how many.
+        // now is wall-clock ns, used to stop waiting on sources that went quiet.
+        std::size_t pump(DataProvider& output, std::int64_t now = nowNanoseconds());
+
+        const SourceStats& stats(std::size_t source) const { return sources[source].stats; }
+        std::size_t buffered() const;
+        std::int64_t lastReleased() const { return released; }
+
+    private:
+        struct Source {
+            SpscQueue<Sample>* queue;
+            std::int64_t lateness;
+            std::int64_t maxSeen;
+            std::int64_t lastArrival;
+            std::vector<Sample> window; // min-heap on timestamp, capacity fixed at addSource
+            std::size_t capacity;
+            SourceStats stats;
+        };
+
+        struct Head {
+            std::int64_t timestamp;
+            std::uint32_t source;
+        };
+
+        bool fill(Source& source, std::int64_t now);
+        std::int64_t watermark(std::int64_t now) const;
+
+        std::vector<Source> sources;
+        std::vector<Head> heads; // min-heap on timestamp, at most one entry per source
+        std::int64_t idleTimeout;
+        std::int64_t released;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_TIMESTAMPMERGER_H
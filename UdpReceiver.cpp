@@ -0,0 +1,268 @@
+#include "UdpReceiver.h"
+#include "DataProvider.h"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace SkyLink {
+
+    namespace {
+        const std::intptr_t InvalidSocket = -1;
+
+        void setReceiveTimeout(std::intptr_t socket, int milliseconds) {
+#ifdef _WIN32
+            DWORD timeoutMs = static_cast<DWORD>(milliseconds);
+            setsockopt(static_cast<SOCKET>(socket), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeoutMs), sizeof(timeoutMs));
+#else
+            timeval timeout;
+            timeout.tv_sec = milliseconds / 1000;
+            timeout.tv_usec = (milliseconds % 1000) * 1000;
+            setsockopt(static_cast<int>(socket), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+        }
+    }
+
+    UdpReceiver::UdpReceiver(DataProvider& target)
+        : target(target), socketHandle(InvalidSocket), localPort(0), running(false),
+        packets(0), bytes(0), calls(0), malformed(0), truncated(0) {
+        storage.resize(BatchSize * MaxPacketBytes);
+        handler = [this](const std::uint8_t* data, std::size_t size) { postSamples(data, size); };
+    }
+
+    UdpReceiver::~UdpReceiver() {
+        stop();
+        close();
+    }
+
+    bool UdpReceiver::setPacketHandler(PacketHandler newHandler) {
+        if (running.load(std::memory_order_acquire)) {
+            std::cerr << "ERROR::UDPRECEIVER::Packet handler can not change while running" << std::endl;
+            return false;
+        }
+        handler = newHandler;
+        return true;
+    }
+
+    bool UdpReceiver::setTickHandler(TickHandler newHandler) {
+        if (running.load(std::memory_order_acquire)) {
+            std::cerr << "ERROR::UDPRECEIVER::Tick handler can not change while running" << std::endl;
+            return false;
+        }
+        tickHandler = newHandler;
+        return true;
+    }
+
+    bool UdpReceiver::open(std::uint16_t port, const std::string& bindAddress) {
+        close();
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            std::cerr << "ERROR::UDPRECEIVER::WSAStartup failed" << std::endl;
+            return false;
+        }
+        SOCKET sock = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sock == INVALID_SOCKET) {
+            std::cerr << "ERROR::UDPRECEIVER::Could not create socket" << std::endl;
+            WSACleanup();
+            return false;
+        }
+#else
+        int sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (sock < 0) {
+            std::cerr << "ERROR::UDPRECEIVER::Could not create socket" << std::endl;
+            return false;
+        }
+#endif
+        // Short timeout so stop() does not hang on a quiet link
+        setReceiveTimeout(static_cast<std::intptr_t>(sock), 100);
+        int receiveBuffer = 4 * 1024 * 1024;
+        setsockopt(sock, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&receiveBuffer), sizeof(receiveBuffer));
+
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if (inet_pton(AF_INET, bindAddress.c_str(), &address.sin_addr) != 1 ||
+            ::bind(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            std::cerr << "ERROR::UDPRECEIVER::Could not bind " << bindAddress << ":" << port << std::endl;
+#ifdef _WIN32
+            closesocket(sock);
+            WSACleanup();
+#else
+            ::close(sock);
+#endif
+            return false;
+        }
+        socklen_t addressLength = sizeof(address);
+        getsockname(sock, reinterpret_cast<sockaddr*>(&address), &addressLength);
+        localPort = ntohs(address.sin_port);
+        socketHandle = static_cast<std::intptr_t>(sock);
+        return true;
+    }
+
+    void UdpReceiver::close() {
+        if (socketHandle == InvalidSocket) {
+            return;
+        }
+#ifdef _WIN32
+        closesocket(static_cast<SOCKET>(socketHandle));
+        WSACleanup();
+#else
+        ::close(static_cast<int>(socketHandle));
+#endif
+        socketHandle = InvalidSocket;
+        localPort = 0;
+    }
+
+    void UdpReceiver::start() {
+        if (running.load() || socketHandle == InvalidSocket) {
+            return;
+        }
+        // A quiet link must still return from the receive call in time for the tick
+        setReceiveTimeout(socketHandle, tickHandler ? TickMilliseconds : 100);
+        running.store(true, std::memory_order_release);
+        worker = std::thread(&UdpReceiver::run, this);
+    }
+
+    void UdpReceiver::stop() {
+        running.store(false, std::memory_order_release);
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void UdpReceiver::postSamples(const std::uint8_t* data, std::size_t size) {
+        // A ragged datagram was cut or mangled on the way; none of its samples can be trusted
+        if (size % sizeof(Sample) != 0) {
+            malformed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Likewise one sample of an unknown type: check them all before posting any
+        for (std::size_t offset = 0; offset < size; offset += sizeof(Sample)) {
+            SampleType type;
+            std::memcpy(&type, data + offset + offsetof(Sample, type), sizeof(type));
+            if (type != SampleType::Int && type != SampleType::Double) {
+                malformed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        for (std::size_t offset = 0; offset < size; offset += sizeof(Sample)) {
+            Sample sample;
+            std::memcpy(&sample, data + offset, sizeof(Sample));
+            target.post(sample);
+        }
+    }
+
+    void UdpReceiver::tickIfDue(std::chrono::steady_clock::time_point& due) {
+        if (!tickHandler) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= due) {
+            tickHandler();
+            due = now + std::chrono::milliseconds(TickMilliseconds);
+        }
+    }
+
+#ifdef __linux__
+
+    void UdpReceiver::run() {
+        const int sock = static_cast<int>(socketHandle);
+        std::vector<mmsghdr> messages(BatchSize);
+        std::vector<iovec> vectors(BatchSize);
+        for (std::size_t i = 0; i < BatchSize; ++i) {
+            vectors[i].iov_base = storage.data() + i * MaxPacketBytes;
+            vectors[i].iov_len = MaxPacketBytes;
+            std::memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        auto nextTick = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_acquire)) {
+            // Blocks for the first datagram, then takes whatever else is already queued
+            const int count = recvmmsg(sock, messages.data(), BatchSize, MSG_WAITFORONE, nullptr);
+            calls.fetch_add(1, std::memory_order_relaxed);
+            tickIfDue(nextTick);
+            if (count <= 0) {
+                continue; // timeout or EINTR
+            }
+            std::uint64_t received = 0;
+            std::uint64_t cut = 0;
+            for (int i = 0; i < count; ++i) {
+                const std::size_t length = messages[i].msg_len;
+                received += length;
+                // Only the first MaxPacketBytes arrived; a partial frame is worse than none
+                if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                    ++cut;
+                    continue;
+                }
+                handler(storage.data() + i * MaxPacketBytes, length);
+            }
+            packets.fetch_add(static_cast<std::uint64_t>(count), std::memory_order_relaxed);
+            bytes.fetch_add(received, std::memory_order_relaxed);
+            if (cut) {
+                truncated.fetch_add(cut, std::memory_order_relaxed);
+            }
+        }
+    }
+
+#else
+
+    void UdpReceiver::run() {
+        // No recvmmsg here: one datagram per call into the same preallocated buffer
+        auto nextTick = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_acquire)) {
+            tickIfDue(nextTick);
+#ifdef _WIN32
+            const int length = ::recv(static_cast<SOCKET>(socketHandle),
+                reinterpret_cast<char*>(storage.data()), static_cast<int>(MaxPacketBytes), 0);
+            calls.fetch_add(1, std::memory_order_relaxed);
+            if (length == SOCKET_ERROR && WSAGetLastError() == WSAEMSGSIZE) {
+                truncated.fetch_add(1, std::memory_order_relaxed);
+                packets.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+#else
+            iovec vector;
+            vector.iov_base = storage.data();
+            vector.iov_len = MaxPacketBytes;
+            msghdr message;
+            std::memset(&message, 0, sizeof(message));
+            message.msg_iov = &vector;
+            message.msg_iovlen = 1;
+            const long length = ::recvmsg(static_cast<int>(socketHandle), &message, 0);
+            calls.fetch_add(1, std::memory_order_relaxed);
+            if (length > 0 && (message.msg_flags & MSG_TRUNC)) {
+                truncated.fetch_add(1, std::memory_order_relaxed);
+                packets.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+#endif
+            if (length <= 0) {
+                continue;
+            }
+            handler(storage.data(), static_cast<std::size_t>(length));
+            packets.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(static_cast<std::uint64_t>(length), std::memory_order_relaxed);
+        }
+    }
+
+#endif
+
+} // namespace SkyLine
@@ -0,0 +1,80 @@
+#ifndef SKYLINE_UDPRECEIVER_H
+#define SKYLINE_UDPRECEIVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SkyLink {
+
+    class DataProvider;
+
+    // Network telemetry source. A dedicated thread pulls datagrams from a UDP
+    // socket in batches (recvmmsg on Linux) into preallocated buffers and
+    // hands each one to the packet handler, which feeds the ingest queue.
+    class UdpReceiver {
+    public:
+        typedef std::function<void(const std::uint8_t* data, std::size_t size)> PacketHandler;
+        typedef std::function<void()> TickHandler;
+
+        static const std::size_t BatchSize = 64;        // datagrams per receive call
+        static const std::size_t MaxPacketBytes = 2048; // larger datagrams are dropped and counted
+        static const int TickMilliseconds = 10;         // tick period, and the receive timeout while ticking
+
+        explicit UdpReceiver(DataProvider& target);
+        ~UdpReceiver();
+
+        // Port 0 binds an ephemeral port, see port()
+        bool open(std::uint16_t port, const std::string& bindAddress = "0.0.0.0");
+        void close();
+        std::uint16_t port() const { return localPort; }
+
+        // Default handler: datagram is a run of packed Sample structs; a datagram
+        // that is not a whole number of samples, or holds any sample of an unknown
+        // type, is counted as malformed and dropped whole.
+        // The receive thread calls the handler unlocked, so set it before start();
+        // while running the call is refused.
+        bool setPacketHandler(PacketHandler handler);
+        // Called on the receive thread every TickMilliseconds or so, also while no
+        // datagram arrives (MavlinkDecoder::tick). Same rules as the packet handler.
+        bool setTickHandler(TickHandler handler);
+
+        void start();
+        void stop();
+        bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+        std::uint64_t packetsReceived() const { return packets.load(std::memory_order_relaxed); }
+        std::uint64_t bytesReceived() const { return bytes.load(std::memory_order_relaxed); }
+        std::uint64_t receiveCalls() const { return calls.load(std::memory_order_relaxed); }
+        std::uint64_t malformedPackets() const { return malformed.load(std::memory_order_relaxed); }
+        std::uint64_t truncatedPackets() const { return truncated.load(std::memory_order_relaxed); } // > MaxPacketBytes
+
+    private:
+        void run();
+        void postSamples(const std::uint8_t* data, std::size_t size);
+        void tickIfDue(std::chrono::steady_clock::time_point& due);
+
+        DataProvider& target;
+        PacketHandler handler;
+        TickHandler tickHandler;
+        std::intptr_t socketHandle;
+        std::uint16_t localPort;
+        std::thread worker;
+        std::atomic<bool> running;
+        std::vector<std::uint8_t> storage; // BatchSize * MaxPacketBytes
+
+        std::atomic<std::uint64_t> packets;
+        std::atomic<std::uint64_t> bytes;
+        std::atomic<std::uint64_t> calls;
+        std::atomic<std::uint64_t> malformed;
+        std::atomic<std::uint64_t> truncated;
+    };
+
+} // namespace SkyLine
+
+#endif // SKYLINE_UDPRECEIVER_H
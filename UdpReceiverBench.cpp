@@ -0,0 +1,213 @@
+// Loopback vehicle: a plain UDP socket sends packed Sample datagrams to a
+// UdpReceiver on 127.0.0.1. Every sample sent must come out of drain() in
+// order, and oversized or ragged datagrams, or ones holding a sample of an
+// unknown type, must be counted, not delivered in part.
+// On a MAVLink link that goes quiet behind a lost frame, the receive thread's
+// tick must release the held frames without another datagram arriving.
+#include "Bench.h"
+#include "DataProvider.h"
+#include "MavlinkDecoder.h"
+#include "UdpReceiver.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace SkyLink {
+
+    namespace {
+
+        const std::size_t SamplesPerPacket = 16;
+        const std::uint64_t PacketCount = 50000;
+        const std::uint64_t InFlight = 256; // paced so the socket buffer never overflows
+
+        class SequenceCheck : public Observer {
+        public:
+            std::uint64_t next = 0;
+            std::uint64_t outOfOrder = 0;
+
+            void onSamples(SampleSpan samples) override {
+                for (const Sample& sample : samples) {
+                    if (sample.type != SampleType::Int || sample.intValue != static_cast<std::int64_t>(next)) {
+                        ++outOfOrder;
+                    }
+                    next = static_cast<std::uint64_t>(sample.intValue) + 1;
+                }
+            }
+        };
+
+        class Sender {
+        public:
+            explicit Sender(std::uint16_t port) {
+#ifdef _WIN32
+                WSADATA wsaData;
+                WSAStartup(MAKEWORD(2, 2), &wsaData);
+                sock = static_cast<std::intptr_t>(::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+#else
+                sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+#endif
+                std::memset(&destination, 0, sizeof(destination));
+                destination.sin_family = AF_INET;
+                destination.sin_port = htons(port);
+                inet_pton(AF_INET, "127.0.0.1", &destination.sin_addr);
+            }
+
+            ~Sender() {
+#ifdef _WIN32
+                closesocket(static_cast<SOCKET>(sock));
+                WSACleanup();
+#else
+                ::close(static_cast<int>(sock));
+#endif
+            }
+
+            bool send(const void* data, std::size_t size) {
+#ifdef _WIN32
+                return ::sendto(static_cast<SOCKET>(sock), static_cast<const char*>(data), static_cast<int>(size), 0,
+                    reinterpret_cast<const sockaddr*>(&destination), sizeof(destination)) == static_cast<int>(size);
+#else
+                return ::sendto(static_cast<int>(sock), data, size, 0,
+                    reinterpret_cast<const sockaddr*>(&destination), sizeof(destination)) == static_cast<long>(size);
+#endif
+            }
+
+        private:
+            std::intptr_t sock;
+            sockaddr_in destination;
+        };
+
+        class RollValues : public Observer {
+        public:
+            std::vector<double> values;
+
+            void onSamples(SampleSpan samples) override {
+                for (const Sample& sample : samples) {
+                    values.push_back(sample.asDouble());
+                }
+            }
+        };
+
+        // Frames 0, 2 and 3 and then silence: only the receiver's tick handler can release 2 and 3
+        bool quietLinkTicks() {
+            const std::int64_t hold = 20ll * 1000 * 1000; // 20 ms
+            DataProvider provider(1024);
+            RollValues roll;
+            provider.attach(&roll, 0);
+            MavlinkDecoder decoder(provider);
+            decoder.bindCommonTelemetry(0);
+            decoder.trackSequences(16, hold);
+
+            UdpReceiver receiver(provider);
+            receiver.setPacketHandler([&decoder](const std::uint8_t* data, std::size_t size) {
+                decoder.feed(data, size);
+                });
+            receiver.setTickHandler([&decoder]() {
+                decoder.tick();
+                });
+            if (!receiver.open(0, "127.0.0.1")) {
+                return false;
+            }
+            receiver.start();
+            Sender sender(receiver.port());
+            for (std::uint8_t sequence : { 0, 2, 3 }) {
+                const std::vector<std::uint8_t> frame = attitudeFrame(sequence, sequence, sequence); // roll carries the sequence number
+                sender.send(frame.data(), frame.size());
+            }
+            const auto start = std::chrono::steady_clock::now();
+            while (roll.values.size() < 3 && secondsSince(start) < 2.0) {
+                provider.drain();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            const double seconds = secondsSince(start);
+            receiver.stop();
+            provider.drain();
+
+            const bool released = roll.values == std::vector<double>{ 0.0, 2.0, 3.0 } &&
+                decoder.linkCount() == 1 && decoder.link(0).gapCount() == 1;
+            std::printf("quiet link: held frames released by the receive thread after %.1f ms: %s\n",
+                seconds * 1e3, released ? "yes" : "no");
+            return released;
+        }
+
+    } // namespace
+
+    bool benchUdpLoopback() {
+        DataProvider provider(1 << 16);
+        SequenceCheck check;
+        provider.attach(&check);
+
+        UdpReceiver receiver(provider);
+        if (!receiver.open(0, "127.0.0.1")) {
+            return false;
+        }
+        receiver.start();
+        const bool handlerRefused = !receiver.setPacketHandler([](const std::uint8_t*, std::size_t) {});
+
+        Sender sender(receiver.port());
+        Sample packet[SamplesPerPacket];
+        std::uint64_t value = 0;
+        std::uint64_t delivered = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t sent = 0; sent < PacketCount; ++sent) {
+            for (Sample& sample : packet) {
+                sample = Sample::fromInt(1, static_cast<std::int64_t>(value), static_cast<std::int64_t>(value));
+                ++value;
+            }
+            sender.send(packet, sizeof(packet));
+            while (sent + 1 > receiver.packetsReceived() + InFlight) {
+                delivered += provider.drain();
+                std::this_thread::yield();
+            }
+        }
+        const double seconds = secondsSince(start);
+        while (receiver.packetsReceived() < PacketCount && secondsSince(start) < seconds + 2.0) {
+            delivered += provider.drain();
+            std::this_thread::yield();
+        }
+        delivered += provider.drain();
+
+        // One datagram over MaxPacketBytes, one that is not a whole number of samples,
+        // and one whose valid samples surround a sample of an unknown type
+        std::vector<std::uint8_t> oversized(UdpReceiver::MaxPacketBytes + 512, 0);
+        sender.send(oversized.data(), oversized.size());
+        sender.send(packet, sizeof(Sample) + 3);
+        const SampleType unknownType = static_cast<SampleType>(7);
+        std::memcpy(reinterpret_cast<std::uint8_t*>(&packet[1]) + offsetof(Sample, type), &unknownType, sizeof(unknownType));
+        sender.send(packet, 3 * sizeof(Sample));
+        const auto tail = std::chrono::steady_clock::now();
+        while (receiver.packetsReceived() < PacketCount + 3 && secondsSince(tail) < 2.0) {
+            std::this_thread::yield();
+        }
+        receiver.stop();
+        const std::size_t late = provider.drain(); // none of them may deliver anything
+
+        const std::uint64_t expected = PacketCount * SamplesPerPacket;
+        std::printf("%llu packets, %llu samples in %.3f s: %.0f packets/s, %.1f packets per receive call\n",
+            static_cast<unsigned long long>(receiver.packetsReceived()), static_cast<unsigned long long>(delivered),
+            seconds, PacketCount / seconds,
+            static_cast<double>(receiver.packetsReceived()) / static_cast<double>(receiver.receiveCalls()));
+        std::printf("out of order %llu, truncated %llu, malformed %llu (%zu samples delivered), queue drops %llu, handler refused while running: %s\n",
+            static_cast<unsigned long long>(check.outOfOrder), static_cast<unsigned long long>(receiver.truncatedPackets()),
+            static_cast<unsigned long long>(receiver.malformedPackets()), late,
+            static_cast<unsigned long long>(provider.ingestQueue().dropCount()), handlerRefused ? "yes" : "no");
+
+        const bool ticked = quietLinkTicks();
+        return delivered == expected && check.outOfOrder == 0 && receiver.truncatedPackets() == 1 &&
+            receiver.malformedPackets() == 2 && late == 0 && handlerRefused && ticked;
+    }
+
+} // namespace SkyLine